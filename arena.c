@@ -0,0 +1,100 @@
+/**
+ * File containing an arena allocator for records that are all released at
+ * once. Records are carved out of large blocks, which double in size up to
+ * a limit, so there is no per record allocation overhead and freeing the
+ * arena costs one free per block.
+ * @file arena.c
+ * @author @inesiscosta
+ */
+
+#include "arena.h"
+
+/**
+ * Initializes an empty arena, which reserves no memory until first used.
+ * @param arena the arena to be initialized
+ */
+void arena_init(Arena *arena) {
+    arena->blocks = NULL;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+}
+
+/**
+ * Rounds a size up to the alignment of the records in the arena.
+ * @param size the size
+ * @return the aligned size
+ */
+static size_t align_size(size_t size) {
+    size_t alignment = sizeof(max_align_t);
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Adds a new block to the arena, twice the size of the previous one.
+ * @param arena the arena
+ * @param size the minimum number of bytes the block must hold
+ */
+static void add_block(Arena *arena, size_t size) {
+    size_t block_size = arena->blocks != NULL ?
+    arena->blocks->size * 2 : ARENA_INITIAL_BLOCK_SIZE;
+    if (block_size > ARENA_MAX_BLOCK_SIZE)
+        block_size = ARENA_MAX_BLOCK_SIZE;
+    if (block_size < size)
+        block_size = size;
+    STATS_COUNT(allocations);
+    ArenaBlock *block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + block_size);
+    block->next = arena->blocks;
+    block->size = block_size;
+    block->used = 0;
+    arena->blocks = block;
+    arena->bytes_reserved += sizeof(ArenaBlock) + block_size;
+}
+
+/**
+ * Allocates a record from the arena. It stays valid until the arena is freed.
+ * @param arena the arena
+ * @param size the size of the record
+ * @return the record
+ */
+void *arena_alloc(Arena *arena, size_t size) {
+    size = align_size(size);
+    if (arena->blocks == NULL || arena->blocks->size - arena->blocks->used <
+    size)
+        add_block(arena, size);
+    void *record = (char *)arena->blocks->data + arena->blocks->used;
+    arena->blocks->used += size;
+    arena->bytes_used += size;
+    return record;
+}
+
+/**
+ * Frees every record of the arena at once, leaving it empty.
+ * @param arena the arena
+ */
+void arena_free(Arena *arena) {
+    while (arena->blocks != NULL) {
+        ArenaBlock *next = arena->blocks->next;
+        free(arena->blocks);
+        arena->blocks = next;
+    }
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+}
+
+/**
+ * Gets the number of bytes handed out by the arena.
+ * @param arena the arena
+ * @return the bytes in use by records
+ */
+size_t arena_bytes_used(Arena *arena) {
+    return arena->bytes_used;
+}
+
+/**
+ * Gets the number of bytes the arena obtained from the system.
+ * @param arena the arena
+ * @return the bytes reserved, block headers and unused space included
+ */
+size_t arena_bytes_reserved(Arena *arena) {
+    return arena->bytes_reserved;
+}
@@ -0,0 +1,40 @@
+/**
+ * Header file for arena.c
+ * @file arena.h
+ * @author @inesiscosta
+*/
+
+#ifndef ARENA
+#define ARENA
+
+/*Includes*/
+#include <stdlib.h>
+#include <stddef.h>
+#include "stats.h"
+
+/*Constants*/
+#define ARENA_INITIAL_BLOCK_SIZE 4096
+#define ARENA_MAX_BLOCK_SIZE (1 << 20)
+
+/*Arena Block Structure*/
+typedef struct ArenaBlock {
+    struct ArenaBlock *next; // block allocated before this one
+    size_t size; // bytes available in data
+    size_t used;
+    max_align_t data[]; // aligned for any kind of record
+} ArenaBlock;
+
+/*Arena Structure*/
+typedef struct Arena {
+    ArenaBlock *blocks; // most recent block first
+    size_t bytes_used; // bytes handed out by arena_alloc
+    size_t bytes_reserved; // bytes obtained from malloc, headers included
+} Arena;
+
+/*Function Prototypes*/
+void arena_init(Arena *arena);
+void *arena_alloc(Arena *arena, size_t size);
+void arena_free(Arena *arena);
+size_t arena_bytes_used(Arena *arena);
+size_t arena_bytes_reserved(Arena *arena);
+#endif
@@ -0,0 +1,144 @@
+/**
+ * Benchmark runner for the park management system. It replays a command
+ * stream through the same code as the program, discarding the program's
+ * output, and reports the throughput and the latency percentiles of every
+ * type of command.
+ * @file bench_runner.c
+ * @author @inesiscosta
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include "parking_lot.h"
+#include "vehicle.h"
+#include "command.h"
+#include "input.h"
+#include "output.h"
+
+/*Constants*/
+#define COMMAND_TYPES 256
+#define INITIAL_SAMPLES_CAPACITY 1024
+
+/*Latency Samples Structure, the durations of one type of command*/
+typedef struct Samples {
+    long long *nanoseconds;
+    long count;
+    long capacity;
+    long long total;
+} Samples;
+
+/**
+ * Reads a monotonic clock.
+ * @return the current time in nanoseconds
+ */
+long long now() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/**
+ * Adds the duration of a command to the samples of its type.
+ * @param samples the samples of the command's type
+ * @param nanoseconds the duration of the command
+ */
+void add_sample(Samples *samples, long long nanoseconds) {
+    if (samples->count == samples->capacity) {
+        samples->capacity = samples->capacity == 0 ?
+        INITIAL_SAMPLES_CAPACITY : samples->capacity * 2;
+        samples->nanoseconds = realloc(samples->nanoseconds,
+        samples->capacity * sizeof(long long));
+    }
+    samples->nanoseconds[samples->count++] = nanoseconds;
+    samples->total += nanoseconds;
+}
+
+/**
+ * Compares two durations, to be used with qsort.
+ * @param a pointer to the first duration
+ * @param b pointer to the second duration
+ * @return negative, 0 or positive as in strcmp
+ */
+int compare_durations(const void *a, const void *b) {
+    long long duration1 = *(const long long *)a;
+    long long duration2 = *(const long long *)b;
+    return (duration1 > duration2) - (duration1 < duration2);
+}
+
+/**
+ * Gets a percentile of sorted durations.
+ * @param samples the samples, sorted
+ * @param percentile the percentile, between 0 and 100
+ * @return the duration at that percentile
+ */
+long long percentile(Samples *samples, double percentile) {
+    long index = (long)(percentile / 100 * (samples->count - 1) + 0.5);
+    return samples->nanoseconds[index];
+}
+
+/**
+ * Prints the report of the run.
+ * @param report where the report is written
+ * @param samples the samples of every type of command
+ * @param elapsed the duration of the whole run in nanoseconds
+ */
+void print_report(FILE *report, Samples samples[], long long elapsed) {
+    long commands = 0;
+    fprintf(report, "%-4s %10s %10s %12s %10s %10s %10s\n", "cmd", "count",
+    "share", "cmd/s", "p50 ns", "p99 ns", "max ns");
+    for (int type = 0; type < COMMAND_TYPES; type++)
+        commands += samples[type].count;
+    for (int type = 0; type < COMMAND_TYPES; type++) {
+        Samples *current = &samples[type];
+        if (current->count == 0)
+            continue;
+        qsort(current->nanoseconds, current->count, sizeof(long long),
+        compare_durations);
+        fprintf(report, "%-4c %10ld %9.2f%% %12.0f %10lld %10lld %10lld\n",
+        type, current->count, 100.0 * current->count / commands,
+        current->count * 1e9 / current->total, percentile(current, 50),
+        percentile(current, 99), current->nanoseconds[current->count - 1]);
+        free(current->nanoseconds);
+    }
+    fprintf(report, "total %ld commands in %.3f s, %.0f commands/s\n",
+    commands, elapsed / 1e9, commands * 1e9 / elapsed);
+}
+
+/**
+ * Main function, replays the commands of the file given as argument and
+ * prints the report to the standard output.
+ */
+int main(int argc, char *argv[]) {
+    InputReader input;
+    if (argc != 2 || !open_input(&input, argv[1])) {
+        fprintf(stderr, "usage: %s <workload>\n", argv[0]);
+        return 1;
+    }
+    // The program's own output goes to /dev/null, the report to stdout
+    FILE *report = fdopen(dup(STDOUT_FILENO), "w");
+    dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+    static Samples samples[COMMAND_TYPES];
+    Timestamp latest = 0;
+    char *line;
+    initialize_hash_table();
+    initialize_output();
+    long long start = now();
+    while ((line = read_line(&input)) != NULL) {
+        unsigned char type = line[0];
+        long long before = now();
+        int running = process_command(line, &latest);
+        add_sample(&samples[type], now() - before);
+        if (!running)
+            break;
+    }
+    flush_output();
+    long long elapsed = now() - start;
+    cleanup();
+    close_input(&input);
+    print_report(report, samples, elapsed);
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,213 @@
+/**
+ * Generator of synthetic command streams for the park management system's
+ * benchmarks. Every vehicle makes a number of stays, one after the other, in
+ * random parks spread over the days of history, and the entries and exits of
+ * all vehicles are written in chronological order with queries mixed in.
+ * @file workload_gen.c
+ * @author @inesiscosta
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "datetime.h"
+
+/*Constants*/
+#define FIRST_YEAR 2024
+#define MAX_STAY_MINUTES (3 * MINUTES_PER_DAY)
+
+/*Event Structure, the entry or the exit of a stay*/
+typedef struct Event {
+    Timestamp time;
+    int plate;
+    int park;
+    char type; // 'e' or 's'
+} Event;
+
+/*Workload Parameters Structure*/
+typedef struct Parameters {
+    int parks;
+    int plates;
+    int stays_per_plate;
+    int days;
+    double queries_v; // v commands per 100 stays
+    double queries_f; // f commands per 100 stays
+    double queries_r; // r commands per 100 stays, each followed by a new p
+    unsigned int seed;
+} Parameters;
+
+/**
+ * Writes the license plate of a vehicle, in the format AA-00-AA.
+ * @param plate the number of the vehicle
+ */
+void print_plate(int plate) {
+    printf("%c%c-%02d-%c%c", 'A' + plate / 676 % 26, 'A' + plate / 26 % 26,
+    plate / 456976 % 100, 'A' + plate / 17576 % 26, 'A' + plate % 26);
+}
+
+/**
+ * Writes a date in the format DD-MM-AAAA.
+ * @param time a timestamp in that day, in minutes since the first day of
+ * history
+ */
+void print_date(Timestamp time) {
+    int day, month, year;
+    split_date(FIRST_YEAR * DAYS_PER_YEAR + timestamp_day(time), &day,
+    &month, &year);
+    printf("%02d-%02d-%04d", day, month, year);
+}
+
+/**
+ * Writes a date and a time in the format DD-MM-AAAA HH:MM.
+ * @param time the timestamp, in minutes since the first day of history
+ */
+void print_datetime(Timestamp time) {
+    int minutes = (int)(time % MINUTES_PER_DAY);
+    print_date(time);
+    printf(" %02d:%02d", minutes / MINUTES_PER_HOUR,
+    minutes % MINUTES_PER_HOUR);
+}
+
+/**
+ * Writes the command that creates a park.
+ * @param park the number of the park
+ * @param capacity the capacity of the park
+ */
+void print_park(int park, int capacity) {
+    int rate = 10 + park % 40;
+    printf("p P%d %d 0.%02d 0.%02d %d.00\n", park, capacity, rate,
+    rate + 10, 15 + park % 10);
+}
+
+/**
+ * Compares two events by time, exits first on ties so that the spaces they
+ * free can be taken by entries in the same minute.
+ * @param a pointer to the first event
+ * @param b pointer to the second event
+ * @return negative, 0 or positive as in strcmp
+ */
+int compare_events(const void *a, const void *b) {
+    const Event *event1 = a, *event2 = b;
+    if (event1->time != event2->time)
+        return event1->time < event2->time ? -1 : 1;
+    return (event1->type == 'e') - (event2->type == 'e');
+}
+
+/**
+ * Creates the entries and exits of every stay. The history of each vehicle
+ * is split into equal periods and one stay happens inside each of them, so
+ * the stays of a vehicle never overlap.
+ * @param parameters the workload parameters
+ * @param num_events where the number of events created is stored
+ * @return the array of events, sorted by time
+ */
+Event *create_events(Parameters *parameters, long *num_events) {
+    long stays = (long)parameters->plates * parameters->stays_per_plate;
+    Event *events = malloc(2 * stays * sizeof(Event));
+    Timestamp period = (Timestamp)parameters->days * MINUTES_PER_DAY /
+    parameters->stays_per_plate;
+    *num_events = 0;
+    for (long i = 0; i < stays; i++) {
+        int plate = (int)(i / parameters->stays_per_plate);
+        Timestamp start = i % parameters->stays_per_plate * period;
+        Timestamp length = 1 + rand() % (period < MAX_STAY_MINUTES ?
+        period - 1 : MAX_STAY_MINUTES);
+        Timestamp entry = start + rand() % (period - length);
+        int park = rand() % parameters->parks;
+        events[(*num_events)++] = (Event){entry, plate, park, 'e'};
+        events[(*num_events)++] = (Event){entry + length, plate, park, 's'};
+    }
+    qsort(events, *num_events, sizeof(Event), compare_events);
+    return events;
+}
+
+/**
+ * Writes a random query, chosen according to the mix of queries.
+ * @param parameters the workload parameters
+ * @param time the time of the latest event written
+ */
+void print_query(Parameters *parameters, Timestamp time) {
+    double total = parameters->queries_v + parameters->queries_f +
+    parameters->queries_r;
+    double choice = total * rand() / RAND_MAX;
+    int park = rand() % parameters->parks;
+    if (choice < parameters->queries_v) {
+        printf("v ");
+        print_plate(rand() % parameters->plates);
+        printf("\n");
+    } else if (choice < parameters->queries_v + parameters->queries_f) {
+        if (rand() % 2 == 0) {
+            printf("f P%d\n", park);
+        } else {
+            printf("f P%d ", park);
+            print_date(time - rand() % (time + 1));
+            printf("\n");
+        }
+    } else {
+        printf("r P%d\n", park);
+        print_park(park, parameters->plates);
+    }
+}
+
+/**
+ * Writes the whole command stream.
+ * @param parameters the workload parameters
+ */
+void print_workload(Parameters *parameters) {
+    long num_events;
+    Event *events = create_events(parameters, &num_events);
+    double queries_per_event = (parameters->queries_v +
+    parameters->queries_f + parameters->queries_r) / 200.0;
+    double pending_queries = 0;
+    for (int park = 0; park < parameters->parks; park++)
+        print_park(park, parameters->plates);
+    for (long i = 0; i < num_events; i++) {
+        printf("%c P%d ", events[i].type, events[i].park);
+        print_plate(events[i].plate);
+        printf(" ");
+        print_datetime(events[i].time);
+        printf("\n");
+        for (pending_queries += queries_per_event; pending_queries >= 1;
+        pending_queries--)
+            print_query(parameters, events[i].time);
+    }
+    printf("q\n");
+    free(events);
+}
+
+/**
+ * Main function, reads the workload parameters and writes the commands to
+ * the standard output.
+ */
+int main(int argc, char *argv[]) {
+    Parameters parameters = {10, 10000, 10, 365, 5, 2, 0, 1};
+    int option;
+    while ((option = getopt(argc, argv, "p:n:s:d:v:f:r:S:")) != -1) {
+        switch (option) {
+            case 'p': parameters.parks = atoi(optarg); break;
+            case 'n': parameters.plates = atoi(optarg); break;
+            case 's': parameters.stays_per_plate = atoi(optarg); break;
+            case 'd': parameters.days = atoi(optarg); break;
+            case 'v': parameters.queries_v = atof(optarg); break;
+            case 'f': parameters.queries_f = atof(optarg); break;
+            case 'r': parameters.queries_r = atof(optarg); break;
+            case 'S': parameters.seed = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-p parks] [-n plates] "
+                "[-s stays per plate] [-d days] [-v v per 100 stays] "
+                "[-f f per 100 stays] [-r r per 100 stays] [-S seed]\n",
+                argv[0]);
+                return 1;
+        }
+    }
+    if (parameters.parks < 1 || parameters.plates < 1 ||
+    parameters.stays_per_plate < 1 || (Timestamp)parameters.days *
+    MINUTES_PER_DAY < 4LL * parameters.stays_per_plate) {
+        fprintf(stderr, "%s: invalid parameters\n", argv[0]);
+        return 1;
+    }
+    srand(parameters.seed);
+    print_workload(&parameters);
+    return 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * File containing the command parser of the park management system.
+ * A line is split into its arguments in a single pass, without copying them:
+ * each argument is terminated in place and points into the line itself.
+ * @file command.c
+ * @author @inesiscosta
+ */
+
+#include "command.h"
+#include "parking_lot.h"
+#include "vehicle.h"
+#include "utils.h"
+
+/**
+ * Extracts the next argument of a line, which is either a sequence of
+ * characters between quotes or a sequence of non whitespace characters.
+ * The argument is terminated in place, so the line is modified.
+ * @param cursor position in the line, moved past the extracted argument
+ * @return the argument or NULL if there are no more arguments
+ */
+char *next_token(char **cursor) {
+    char *current = *cursor;
+    while (isspace((unsigned char)*current))
+        current++;
+    if (*current == '\0') {
+        *cursor = current;
+        return NULL;
+    }
+    char *token = current;
+    if (*current == '"') {
+        token = ++current;
+        while (*current != '"' && *current != '\0')
+            current++;
+    } else {
+        while (!isspace((unsigned char)*current) && *current != '\0')
+            current++;
+    }
+    if (*current != '\0')
+        *current++ = '\0';
+    *cursor = current;
+    return token;
+}
+
+/**
+ * Splits a line into the command's type and its arguments. Arguments after
+ * the first MAX_ARGUMENTS are ignored, as no command uses them.
+ * @param line the line that was read, modified in place
+ * @param command where the type and the arguments are stored
+ */
+void tokenize_command(char *line, Command *command) {
+    char *cursor = line;
+    command->type = *cursor;
+    command->num_arguments = 0;
+    if (*cursor != '\0')
+        cursor++;
+    char *token;
+    while (command->num_arguments < MAX_ARGUMENTS &&
+    (token = next_token(&cursor)) != NULL)
+        command->arguments[command->num_arguments++] = token;
+}
+
+/**
+ * Parses an argument holding a whole number.
+ * @param text the argument
+ * @param value where the number is stored
+ * @return 1 if the argument is a number that fits in an int, 0 otherwise
+ */
+int parse_integer(char *text, int *value) {
+    int negative = *text == '-';
+    long long result = 0;
+    if (*text == '-' || *text == '+')
+        text++;
+    if (!isdigit((unsigned char)*text))
+        return 0;
+    for (; isdigit((unsigned char)*text); text++) {
+        result = result * 10 + (*text - '0');
+        if (result > INT_MAX)
+            return 0;
+    }
+    *value = negative ? (int)-result : (int)result;
+    return *text == '\0';
+}
+
+/**
+ * Reads the decimal places of an amount of money as a number of cents,
+ * rounding to the nearest cent if there are more than two.
+ * @param text position after the decimal point, moved past the digits
+ * @return the number of cents
+ */
+static Cents parse_decimal_cents(char **text) {
+    Cents cents = 0;
+    int decimals = 0;
+    for (; isdigit((unsigned char)**text); (*text)++, decimals++) {
+        if (decimals < 2)
+            cents = cents * 10 + (**text - '0');
+        else if (decimals == 2 && **text >= '5')
+            cents++;
+    }
+    for (; decimals < 2; decimals++)
+        cents *= 10;
+    return cents;
+}
+
+/**
+ * Parses an argument holding an amount of money, such as 0.25 or 20.
+ * @param text the argument
+ * @param value where the amount is stored in cents
+ * @return 1 if the whole argument is an amount whose whole part fits in an
+ * int, 0 otherwise
+ */
+int parse_cents(char *text, Cents *value) {
+    int negative = *text == '-';
+    Cents euros = 0, cents = 0;
+    if (*text == '-' || *text == '+')
+        text++;
+    char *start = text;
+    for (; isdigit((unsigned char)*text); text++)
+        if ((euros = euros * 10 + (*text - '0')) > INT_MAX)
+            return 0;
+    if (*text == '.') {
+        text++;
+        cents = parse_decimal_cents(&text);
+    }
+    if (text == start || *text != '\0' || (text == start + 1 && *start == '.'))
+        return 0;
+    cents += euros * CENTS_PER_EURO;
+    *value = negative ? -cents : cents;
+    return 1;
+}
+
+/**
+ * Checks whether a command only reads the state of the system, which is the
+ * case for commands v, w, f, i, o, t, l and for command p when it lists the
+ * parks.
+ * @param command the command
+ * @return 1 if the command is a query, 0 otherwise
+ */
+int is_query(Command *command) {
+    return command->type == 'v' || command->type == 'w' ||
+    command->type == 'f' || command->type == 'i' || command->type == 'o' ||
+    command->type == 't' || command->type == 'l' ||
+    (command->type == 'p' && command->num_arguments != MAX_ARGUMENTS);
+}
+
+/**
+ * Calls the function that handles a command that only reads the state of
+ * the system, ignoring unknown commands.
+ * @param command the command
+ * @param latest the latest date and time registered in the system
+ */
+static void run_query_command(Command *command, Timestamp latest) {
+    switch(command->type) {
+        case 'v':
+            list_vehicle_entries_and_exits(command);
+            break;
+        case 'w':
+            show_vehicle_location(command);
+            break;
+        case 'f':
+            list_billings(command, latest);
+            break;
+        case 'i':
+            list_revenue(command, latest);
+            break;
+        case 'o':
+            show_occupancy(command, latest);
+            break;
+        case 't':
+        case 'l':
+            list_top_stays(command);
+            break;
+    }
+}
+
+/**
+ * Calls the function that handles a command.
+ * @param command the command
+ * @param latest the latest date and time registered in the system
+ * @return 0 if the command was q, 1 otherwise
+ */
+static int run_command(Command *command, Timestamp *latest) {
+    switch(command->type) {
+        case 'p':
+            create_parking_lot(command);
+            break;
+        case 'e':
+            register_vehicle_entry(command, latest);
+            break;
+        case 's':
+            register_vehicle_exit(command, latest);
+            break;
+        case 'r':
+            remove_parking_lot(command);
+            break;
+        case 'q':
+            return 0;
+        default:
+            run_query_command(command, *latest);
+    }
+    return 1;
+}
+
+/**
+ * Executes a command that was already split into its arguments.
+ * @param command the command
+ * @param latest the latest date and time registered in the system
+ * @return 0 if the command was q, 1 otherwise
+ */
+int execute_command(Command *command, Timestamp *latest) {
+    STATS_START_COMMAND(command->type);
+    int running = run_command(command, latest);
+    STATS_END_COMMAND();
+    return running;
+}
+
+/**
+ * Processes a single command.
+ * @param line the line that was read, modified in place
+ * @param latest the latest date and time registered in the system
+ * @return 0 if the command was q, 1 otherwise
+ */
+int process_command(char *line, Timestamp *latest) {
+    Command command;
+    tokenize_command(line, &command);
+    return execute_command(&command, latest);
+}
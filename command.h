@@ -0,0 +1,37 @@
+/**
+ * Header file for command.c
+ * @file command.h
+ * @author @inesiscosta
+*/
+
+#ifndef COMMAND
+#define COMMAND
+
+/*Includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <limits.h>
+#include "datetime.h"
+#include "money.h"
+#include "stats.h"
+
+/*Constants*/
+#define MAX_ARGUMENTS 5
+
+/*Command Structure*/
+typedef struct Command {
+    char type; // first character of the line
+    char *arguments[MAX_ARGUMENTS]; // point into the line that was read
+    int num_arguments;
+} Command;
+
+/*Function Prototypes*/
+char *next_token(char **cursor);
+void tokenize_command(char *line, Command *command);
+int parse_integer(char *text, int *value);
+int parse_cents(char *text, Cents *value);
+int is_query(Command *command);
+int execute_command(Command *command, Timestamp *latest);
+int process_command(char *line, Timestamp *latest);
+#endif
@@ -0,0 +1,139 @@
+/**
+ * File containing the calendar functions of the park management system.
+ * Dates and times are parsed into Timestamps once when a command is read and
+ * only turned back into text when printed.
+ * @file datetime.c
+ * @author @inesiscosta
+ */
+
+#include "datetime.h"
+
+// Days in each month, February never has a 29th since the parks close then
+static const int days_in_month[12] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+// Days of the year before the first day of each month
+static const int days_before_month[13] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365
+};
+
+/**
+ * Checks if a date exists in the calendar.
+ * @param day the day of the month
+ * @param month the month
+ * @param year the year
+ * @return 1 if the date is valid, 0 otherwise
+ */
+int is_valid_date(int day, int month, int year) {
+    return year >= 0 && month >= 1 && month <= 12 && day >= 1 &&
+    day <= days_in_month[month - 1];
+}
+
+/**
+ * Checks if a time of the day is valid.
+ * @param hours the hours
+ * @param minutes the minutes
+ * @return 1 if the time is valid, 0 otherwise
+ */
+int is_valid_time(int hours, int minutes) {
+    return hours >= 0 && hours <= 23 && minutes >= 0 && minutes <= 59;
+}
+
+/**
+ * Calculates the number of days elapsed since 01-01-0000 up to a valid date.
+ * @param day the day of the month
+ * @param month the month
+ * @param year the year
+ * @return the number of days elapsed since 01-01-0000
+ */
+int date_to_day(int day, int month, int year) {
+    return year * DAYS_PER_YEAR + days_before_month[month - 1] + day - 1;
+}
+
+/**
+ * Builds the timestamp of a time of the day in a given day.
+ * @param day_number the number of days elapsed since 01-01-0000
+ * @param hours the hours
+ * @param minutes the minutes
+ * @return the number of minutes elapsed since 01-01-0000 00:00
+ */
+Timestamp make_timestamp(int day_number, int hours, int minutes) {
+    return (Timestamp)day_number * MINUTES_PER_DAY +
+    hours * MINUTES_PER_HOUR + minutes;
+}
+
+/**
+ * Reads a field of a date or a time, made of digits and ended by a separator.
+ * @param text position in the string, moved past the separator
+ * @param separator the character expected after the digits
+ * @return the value of the field or -1 if it is malformed
+ */
+static int parse_field(char **text, char separator) {
+    int value = 0, digits = 0;
+    for (; isdigit((unsigned char)**text); (*text)++, digits++)
+        value = value * 10 + (**text - '0');
+    if (digits == 0 || digits > MAX_FIELD_DIGITS || **text != separator)
+        return -1;
+    if (separator != '\0')
+        (*text)++;
+    return value;
+}
+
+/**
+ * Parses a date string in the format DD-MM-AAAA.
+ * @param date the date string
+ * @return the number of days elapsed since 01-01-0000 or -1 if the date is
+ * invalid
+ */
+int parse_date(char *date) {
+    int day = parse_field(&date, '-');
+    int month = day != -1 ? parse_field(&date, '-') : -1;
+    int year = month != -1 ? parse_field(&date, '\0') : -1;
+    if (year == -1 || !is_valid_date(day, month, year))
+        return -1;
+    return date_to_day(day, month, year);
+}
+
+/**
+ * Parses a date string in the format DD-MM-AAAA and a time string in the
+ * format HH:MM.
+ * @param date the date string
+ * @param time the time string
+ * @return the timestamp or NO_TIMESTAMP if the date or the time is invalid
+ */
+Timestamp parse_datetime(char *date, char *time) {
+    int day_number = parse_date(date);
+    int hours = parse_field(&time, ':');
+    int minutes = hours != -1 ? parse_field(&time, '\0') : -1;
+    if (day_number == -1 || minutes == -1 || !is_valid_time(hours, minutes))
+        return NO_TIMESTAMP;
+    return make_timestamp(day_number, hours, minutes);
+}
+
+/**
+ * Gets the day of a timestamp.
+ * @param timestamp the timestamp
+ * @return the number of days elapsed since 01-01-0000
+ */
+int timestamp_day(Timestamp timestamp) {
+    return (int)(timestamp / MINUTES_PER_DAY);
+}
+
+/**
+ * Splits a day into its day of the month, month and year.
+ * @param day_number the number of days elapsed since 01-01-0000
+ * @param day where the day of the month is stored
+ * @param month where the month is stored
+ * @param year where the year is stored
+ */
+void split_date(int day_number, int *day, int *month, int *year) {
+    int day_of_year = day_number % DAYS_PER_YEAR;
+    // Estimate the month assuming 31 day months and correct it at most once
+    int month_index = day_of_year / 31;
+    if (day_of_year >= days_before_month[month_index + 1])
+        month_index++;
+    *day = day_of_year - days_before_month[month_index] + 1;
+    *month = month_index + 1;
+    *year = day_number / DAYS_PER_YEAR;
+}
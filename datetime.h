@@ -0,0 +1,34 @@
+/**
+ * Header file for datetime.c
+ * @file datetime.h
+ * @author @inesiscosta
+*/
+
+#ifndef DATETIME
+#define DATETIME
+
+/*Includes*/
+#include <stdio.h>
+#include <ctype.h>
+
+/*Constants*/
+#define MINUTES_PER_HOUR 60
+#define MINUTES_PER_DAY (24 * MINUTES_PER_HOUR)
+#define DAYS_PER_YEAR 365
+#define NO_TIMESTAMP -1
+// Longest run of digits accepted in a field, years may go up to 99999
+#define MAX_FIELD_DIGITS 5
+
+/*Minutes elapsed since 01-01-0000 00:00, February always has 28 days*/
+typedef long long Timestamp;
+
+/*Function Prototypes*/
+int is_valid_date(int day, int month, int year);
+int is_valid_time(int hours, int minutes);
+int date_to_day(int day, int month, int year);
+Timestamp make_timestamp(int day_number, int hours, int minutes);
+Timestamp parse_datetime(char *date, char *time);
+int parse_date(char *date);
+int timestamp_day(Timestamp timestamp);
+void split_date(int day_number, int *day, int *month, int *year);
+#endif
@@ -0,0 +1,235 @@
+/**
+ * File containing an open addressing hash table keyed by packed license
+ * plates, so that probing compares a single number per slot. The table
+ * grows when its load factor goes over 3/4 and the entries are moved to the
+ * bigger table a few slots at a time, so that no single insertion has to pay
+ * for the whole rehash.
+ * @file hash_table.c
+ * @author @inesiscosta
+ */
+
+#include "hash_table.h"
+
+/**
+ * Computes the hash of a string with FNV-1a followed by a final avalanche
+ * step, so that the low bits used to index a table depend on every character.
+ * @param key the string to be hashed
+ * @return the hash of the string
+ */
+unsigned int hash_function(const char *key) {
+    unsigned int hash = 2166136261u;
+    for (; *key != '\0'; key++)
+        hash = (hash ^ (unsigned char)*key) * 16777619u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * Allocates an array of empty slots.
+ * @param capacity the number of slots, must be a power of two
+ * @return the array of slots
+ */
+static HashSlot *allocate_slots(size_t capacity) {
+    STATS_COUNT(allocations);
+    return (HashSlot *)calloc(capacity, sizeof(HashSlot));
+}
+
+/**
+ * Initializes an empty hash table.
+ * @param table the hash table to be initialized
+ */
+void hash_table_init(HashTable *table) {
+    table->capacity = HASH_TABLE_INITIAL_CAPACITY;
+    table->slots = allocate_slots(table->capacity);
+    table->used = 0;
+    table->size = 0;
+    table->old_slots = NULL;
+    table->old_capacity = 0;
+    table->rehash_index = 0;
+}
+
+/**
+ * Frees the slots of the hash table. The values are owned by the caller.
+ * @param table the hash table to be freed
+ */
+void hash_table_free(HashTable *table) {
+    free(table->slots);
+    free(table->old_slots);
+    table->slots = NULL;
+    table->old_slots = NULL;
+}
+
+/**
+ * Searches an array of slots for a live key using linear probing.
+ * @param slots the array of slots
+ * @param capacity the number of slots in the array
+ * @param key the key being searched
+ * @param hash the hash of the key
+ * @return the slot holding the key or NULL if it isn't in the array
+ */
+static HashSlot *find_slot(HashSlot *slots, size_t capacity, PlateKey key,
+unsigned int hash) {
+    size_t mask = capacity - 1;
+    STATS_COUNT(hash_lookups);
+    for (size_t i = hash & mask; slots[i].key != NO_PLATE;
+    i = (i + 1) & mask) {
+        STATS_COUNT(hash_probe_steps);
+        if (slots[i].key == key && slots[i].value != NULL)
+            return &slots[i];
+    }
+    return NULL;
+}
+
+/**
+ * Stores a key that isn't in the table yet in the first free slot of its
+ * probe sequence, reusing deleted slots.
+ * @param table the hash table
+ * @param key the key to be stored
+ * @param hash the hash of the key
+ * @param value the value associated with the key
+ */
+static void insert_slot(HashTable *table, PlateKey key, unsigned int hash,
+void *value) {
+    size_t mask = table->capacity - 1;
+    size_t i = hash & mask;
+    while (table->slots[i].value != NULL)
+        i = (i + 1) & mask;
+    if (table->slots[i].key == NO_PLATE)
+        table->used++;
+    table->slots[i].key = key;
+    table->slots[i].value = value;
+}
+
+/**
+ * Moves up to max_slots entries from the old slots to the current ones and
+ * frees the old slots once they have all been migrated.
+ * @param table the hash table
+ * @param max_slots the number of old slots to be visited
+ */
+static void rehash_step(HashTable *table, size_t max_slots) {
+    if (table->old_slots == NULL)
+        return;
+    for (; max_slots > 0 && table->rehash_index < table->old_capacity;
+    max_slots--, table->rehash_index++) {
+        HashSlot *slot = &table->old_slots[table->rehash_index];
+        if (slot->value != NULL) {
+            insert_slot(table, slot->key, hash_plate(slot->key), slot->value);
+            // Left as a deleted slot so probe sequences stay unbroken
+            slot->value = NULL;
+        }
+    }
+    if (table->rehash_index == table->old_capacity) {
+        free(table->old_slots);
+        table->old_slots = NULL;
+    }
+}
+
+/**
+ * Starts migrating the table to a new array of slots big enough to hold the
+ * live keys at a load factor of at most 1/2. If most used slots were
+ * deleted ones the capacity stays the same and they're simply dropped.
+ * @param table the hash table
+ */
+static void start_rehash(HashTable *table) {
+    // Only one migration runs at a time
+    rehash_step(table, table->old_capacity);
+    size_t capacity = table->capacity;
+    while (table->size * 2 >= capacity)
+        capacity *= 2;
+    table->old_slots = table->slots;
+    table->old_capacity = table->capacity;
+    table->rehash_index = 0;
+    table->slots = allocate_slots(capacity);
+    table->capacity = capacity;
+    table->used = 0;
+}
+
+/**
+ * Gets the value associated with a key. Lookups never move entries around.
+ * @param table the hash table
+ * @param key the key being searched
+ * @return the value associated with the key or NULL if there is none
+ */
+void *hash_table_get(HashTable *table, PlateKey key) {
+    unsigned int hash = hash_plate(key);
+    HashSlot *slot = find_slot(table->slots, table->capacity, key, hash);
+    if (slot == NULL && table->old_slots != NULL)
+        slot = find_slot(table->old_slots, table->old_capacity, key, hash);
+    return slot != NULL ? slot->value : NULL;
+}
+
+/**
+ * Associates a value with a key, replacing the previous value if the key is
+ * already in the table.
+ * @param table the hash table
+ * @param key the key
+ * @param value the value, must not be NULL
+ */
+void hash_table_put(HashTable *table, PlateKey key, void *value) {
+    unsigned int hash = hash_plate(key);
+    HashSlot *slot = find_slot(table->slots, table->capacity, key, hash);
+    if (slot != NULL) {
+        slot->value = value;
+        return;
+    }
+    if (table->old_slots != NULL) {
+        slot = find_slot(table->old_slots, table->old_capacity, key, hash);
+        if (slot != NULL) {
+            // The key is moved to the new slots right away
+            slot->value = NULL;
+            table->size--;
+        }
+    }
+    insert_slot(table, key, hash, value);
+    table->size++;
+    rehash_step(table, HASH_TABLE_REHASH_STEP);
+    if (table->used * HASH_TABLE_MAX_LOAD_DENOMINATOR >
+    table->capacity * HASH_TABLE_MAX_LOAD_NUMERATOR)
+        start_rehash(table);
+}
+
+/**
+ * Removes a key from the table. Removing only marks the slot as deleted, so
+ * it is safe to do while iterating with hash_table_next.
+ * @param table the hash table
+ * @param key the key to be removed
+ * @return the value that was associated with the key or NULL if there was none
+ */
+void *hash_table_remove(HashTable *table, PlateKey key) {
+    unsigned int hash = hash_plate(key);
+    HashSlot *slot = find_slot(table->slots, table->capacity, key, hash);
+    if (slot == NULL && table->old_slots != NULL)
+        slot = find_slot(table->old_slots, table->old_capacity, key, hash);
+    if (slot == NULL)
+        return NULL;
+    void *value = slot->value;
+    slot->value = NULL;
+    table->size--;
+    return value;
+}
+
+/**
+ * Iterates over the live entries of the table. The cursor must start at 0.
+ * @param table the hash table
+ * @param cursor the position of the iteration, updated on each call
+ * @param key where the key of the entry is stored, may be NULL
+ * @return the value of the next entry or NULL when there are no more entries
+ */
+void *hash_table_next(HashTable *table, size_t *cursor, PlateKey *key) {
+    size_t old_capacity = table->old_slots != NULL ? table->old_capacity : 0;
+    for (; *cursor < table->capacity + old_capacity; (*cursor)++) {
+        HashSlot *slot = *cursor < table->capacity ?
+        &table->slots[*cursor] : &table->old_slots[*cursor - table->capacity];
+        if (slot->value != NULL) {
+            if (key != NULL)
+                *key = slot->key;
+            (*cursor)++;
+            return slot->value;
+        }
+    }
+    return NULL;
+}
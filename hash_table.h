@@ -0,0 +1,49 @@
+/**
+ * Header file for hash_table.c
+ * @file hash_table.h
+ * @author @inesiscosta
+*/
+
+#ifndef HASH_TABLE
+#define HASH_TABLE
+
+/*Includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+#include "plate.h"
+
+/*Constants*/
+#define HASH_TABLE_INITIAL_CAPACITY 128
+// A rehash starts once live keys plus tombstones exceed 3/4 of the slots
+#define HASH_TABLE_MAX_LOAD_NUMERATOR 3
+#define HASH_TABLE_MAX_LOAD_DENOMINATOR 4
+// Number of old slots migrated by each insertion while rehashing
+#define HASH_TABLE_REHASH_STEP 64
+
+/*Hash Slot Structure*/
+typedef struct HashSlot {
+    PlateKey key; // NO_PLATE if the slot was never used
+    void *value; // NULL with a key marks a deleted slot
+} HashSlot;
+
+/*Hash Table Structure*/
+typedef struct HashTable {
+    HashSlot *slots;
+    size_t capacity;
+    size_t used; // live and deleted slots in slots
+    size_t size; // live keys in both slots and old_slots
+    HashSlot *old_slots; // table being migrated or NULL if not rehashing
+    size_t old_capacity;
+    size_t rehash_index; // next slot of old_slots to be migrated
+} HashTable;
+
+/*Function Prototypes*/
+unsigned int hash_function(const char *key);
+void hash_table_init(HashTable *table);
+void hash_table_free(HashTable *table);
+void *hash_table_get(HashTable *table, PlateKey key);
+void hash_table_put(HashTable *table, PlateKey key, void *value);
+void *hash_table_remove(HashTable *table, PlateKey key);
+void *hash_table_next(HashTable *table, size_t *cursor, PlateKey *key);
+#endif
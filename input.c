@@ -0,0 +1,147 @@
+/**
+ * File containing the input reader of the park management system.
+ * Regular files given as an argument are mapped into memory, anything else
+ * is read in large blocks. Lines are handed out in place, terminated where
+ * their newline was, so they are never copied.
+ * @file input.c
+ * @author @inesiscosta
+ */
+
+#include "input.h"
+
+/**
+ * Maps a regular file into memory. The mapping is private, so the commands
+ * can be terminated in place without changing the file.
+ * @param reader the input reader
+ * @return 1 if the file was mapped, 0 otherwise
+ */
+static int map_input(InputReader *reader) {
+    struct stat file_stat;
+    if (fstat(reader->fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) ||
+    file_stat.st_size == 0)
+        return 0;
+    void *data = mmap(NULL, file_stat.st_size, PROT_READ | PROT_WRITE,
+    MAP_PRIVATE, reader->fd, 0);
+    if (data == MAP_FAILED)
+        return 0;
+    madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+    reader->data = data;
+    reader->length = file_stat.st_size;
+    reader->end_of_file = 1;
+    return 1;
+}
+
+/**
+ * Opens the input of the program.
+ * @param reader the input reader to be initialized
+ * @param path the file with the commands or NULL to read the standard input
+ * @return 1 if the input was opened, 0 otherwise
+ */
+int open_input(InputReader *reader, const char *path) {
+    reader->fd = path != NULL ? open(path, O_RDONLY) : STDIN_FILENO;
+    reader->data = NULL;
+    reader->length = 0;
+    reader->position = 0;
+    reader->capacity = 0;
+    reader->end_of_file = 0;
+    if (reader->fd == -1)
+        return 0;
+    if (path != NULL && map_input(reader))
+        return 1;
+    reader->capacity = INPUT_BLOCK_SIZE;
+    reader->data = (char *)malloc(reader->capacity + 1);
+    return 1;
+}
+
+/**
+ * Reads the next block of input into the buffer, after moving the unread
+ * part of the buffer to its start and growing it if it is already full.
+ * @param reader the input reader
+ */
+static void read_block(InputReader *reader) {
+    size_t unread = reader->length - reader->position;
+    memmove(reader->data, reader->data + reader->position, unread);
+    reader->length = unread;
+    reader->position = 0;
+    if (reader->length == reader->capacity) {
+        reader->capacity *= 2;
+        reader->data = (char *)realloc(reader->data, reader->capacity + 1);
+    }
+    ssize_t bytes_read = read(reader->fd, reader->data + reader->length,
+    reader->capacity - reader->length);
+    if (bytes_read <= 0)
+        reader->end_of_file = 1;
+    else
+        reader->length += bytes_read;
+}
+
+/**
+ * Moves the last line of a mapped file, which has no newline after it, to a
+ * buffer with room for its terminator.
+ * @param reader the input reader
+ * @return the line
+ */
+static char *copy_last_line(InputReader *reader) {
+    size_t line_length = reader->length - reader->position;
+    char *line = (char *)malloc(line_length + 1);
+    memcpy(line, reader->data + reader->position, line_length);
+    line[line_length] = '\0';
+    munmap(reader->data, reader->length);
+    reader->data = line;
+    reader->length = line_length;
+    reader->position = line_length;
+    reader->capacity = line_length;
+    return line;
+}
+
+/**
+ * Gets the next line of input, without its newline. The line stays valid
+ * until the next call and may be modified by the caller.
+ * @param reader the input reader
+ * @return the line or NULL once the whole input has been read
+ */
+char *read_line(InputReader *reader) {
+    while (1) {
+        char *start = reader->data + reader->position;
+        size_t unread = reader->length - reader->position;
+        char *newline = memchr(start, '\n', unread);
+        if (newline != NULL) {
+            *newline = '\0';
+            reader->position += newline - start + 1;
+            return start;
+        }
+        if (reader->end_of_file) {
+            if (unread == 0)
+                return NULL;
+            if (reader->capacity == 0)
+                return copy_last_line(reader);
+            start[unread] = '\0';
+            reader->position = reader->length;
+            return start;
+        }
+        read_block(reader);
+    }
+}
+
+/**
+ * Checks whether the next line can be read without waiting for more input,
+ * which is the case while part of the last block read is left.
+ * @param reader the input reader
+ * @return 1 if reading doesn't have to wait, 0 otherwise
+ */
+int has_buffered_input(InputReader *reader) {
+    return reader->end_of_file || reader->position < reader->length;
+}
+
+/**
+ * Closes the input and frees its buffer.
+ * @param reader the input reader
+ */
+void close_input(InputReader *reader) {
+    if (reader->capacity == 0 && reader->data != NULL)
+        munmap(reader->data, reader->length);
+    else
+        free(reader->data);
+    if (reader->fd != STDIN_FILENO && reader->fd != -1)
+        close(reader->fd);
+}
@@ -0,0 +1,37 @@
+/**
+ * Header file for input.c
+ * @file input.h
+ * @author @inesiscosta
+*/
+
+#ifndef INPUT
+#define INPUT
+
+/*Includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*Constants*/
+#define INPUT_BLOCK_SIZE (1 << 16)
+
+/*Input Reader Structure*/
+typedef struct InputReader {
+    int fd;
+    char *data; // mapped file or buffer holding the blocks read so far
+    size_t length; // bytes of data available
+    size_t position; // start of the next line in data
+    size_t capacity; // size of the buffer, 0 when the file is mapped
+    int end_of_file;
+} InputReader;
+
+/*Function Prototypes*/
+int open_input(InputReader *reader, const char *path);
+char *read_line(InputReader *reader);
+int has_buffered_input(InputReader *reader);
+void close_input(InputReader *reader);
+#endif
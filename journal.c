@@ -0,0 +1,411 @@
+/**
+ * File containing the event journal of the park management system.
+ * Every change accepted by commands p, e, s and r is appended to the journal
+ * as a binary record, so that the changes made since the last snapshot
+ * survive a crash. Events are written out in groups and the file is synced
+ * at most once per interval. On start the journal is replayed on top of the
+ * snapshot without validating the events again, as only valid ones are
+ * recorded.
+ * @file journal.c
+ * @author @inesiscosta
+ */
+
+#include "journal.h"
+#include "parking_lot.h"
+#include "vehicle.h"
+
+Journal journal = {-1, DEFAULT_GROUP_COMMIT, 0, 0, 0, 0, {0, 0}, {0}};
+
+/**
+ * Rounds a size up to the alignment of the journal's records.
+ * @param size the size
+ * @return the aligned size
+ */
+static size_t journal_align(size_t size) {
+    return (size + JOURNAL_ALIGNMENT - 1) / JOURNAL_ALIGNMENT *
+    JOURNAL_ALIGNMENT;
+}
+
+/**
+ * Continues the FNV-1a checksum of an event with some of its bytes.
+ * @param checksum the checksum of the bytes before these
+ * @param data the bytes
+ * @param size the number of bytes
+ * @return the checksum including the bytes
+ */
+static uint32_t journal_checksum(uint32_t checksum, const void *data,
+size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
+        checksum = (checksum ^ bytes[i]) * 16777619u;
+    return checksum;
+}
+
+/**
+ * Computes the checksum of an event.
+ * @param record the event's record, whose checksum field is ignored
+ * @param payload the bytes that follow the record, may be NULL
+ * @param size the number of bytes in the payload
+ * @return the checksum of the event
+ */
+static uint32_t event_checksum(const JournalRecord *record,
+const void *payload, size_t size) {
+    JournalRecord copy = *record;
+    copy.checksum = 0;
+    return journal_checksum(journal_checksum(2166136261u, &copy,
+    sizeof(copy)), payload, size);
+}
+
+/**
+ * Stops keeping the journal after it couldn't be written.
+ */
+static void abandon_journal() {
+    perror("journal");
+    close(journal.fd);
+    journal.fd = -1;
+    journal.length = 0;
+    journal.pending = 0;
+}
+
+/**
+ * Writes bytes to the end of the journal file.
+ * @param data the bytes
+ * @param size the number of bytes
+ * @return 1 if every byte was written, 0 otherwise
+ */
+static int write_journal(const void *data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t bytes = write(journal.fd, (const char *)data + written,
+        size - written);
+        if (bytes <= 0)
+            return 0;
+        written += bytes;
+    }
+    return 1;
+}
+
+/**
+ * Syncs the journal file if the sync interval has gone by since the last
+ * sync.
+ * @return 1 if the file didn't need a sync or was synced, 0 otherwise
+ */
+static int sync_journal_if_due() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long elapsed = (now.tv_sec - journal.last_sync.tv_sec) *
+    MILLISECONDS_PER_SECOND + (now.tv_nsec - journal.last_sync.tv_nsec) /
+    NANOSECONDS_PER_MILLISECOND;
+    if (elapsed < journal.sync_interval)
+        return 1;
+    journal.last_sync = now;
+    return fdatasync(journal.fd) == 0;
+}
+
+/**
+ * Writes out the events in the buffer as one group, syncing the journal
+ * file if it's due.
+ */
+void commit_journal() {
+    if (journal.fd == -1 || journal.length == 0)
+        return;
+    if (!write_journal(journal.buffer, journal.length) ||
+    !sync_journal_if_due()) {
+        abandon_journal();
+        return;
+    }
+    journal.length = 0;
+    journal.pending = 0;
+}
+
+/**
+ * Adds bytes of an event to the buffer, writing out the buffer first if
+ * they don't fit. Bytes that don't fit in an empty buffer are written
+ * straight away.
+ * @param data the bytes
+ * @param size the number of bytes
+ */
+static void append_bytes(const void *data, size_t size) {
+    if (journal.fd != -1 && journal.length + size > JOURNAL_BUFFER_SIZE)
+        commit_journal();
+    if (journal.fd == -1)
+        return;
+    if (size > JOURNAL_BUFFER_SIZE) {
+        if (!write_journal(data, size))
+            abandon_journal();
+        return;
+    }
+    memcpy(journal.buffer + journal.length, data, size);
+    journal.length += size;
+}
+
+/**
+ * Ends an event, writing out the buffer once it holds a full group.
+ */
+static void end_event() {
+    if (journal.fd != -1 && ++journal.pending >= journal.group_size)
+        commit_journal();
+}
+
+/**
+ * Records the creation of a parking lot.
+ * @param park_id the id given to the parking lot
+ * @param name the parking lot's name
+ * @param capacity the parking lot's capacity
+ * @param rates the quarter hourly rate, the quarter hourly rate after the
+ * first hour and the max daily cost, in this order
+ */
+void journal_park(int park_id, const char *name, int capacity,
+Cents rates[3]) {
+    static const char padding[JOURNAL_ALIGNMENT] = {0};
+    journal.sequence++;
+    if (journal.fd == -1)
+        return;
+    JournalRecord record = {0, NO_PLATE, park_id, 0, 'p', {0}};
+    JournalPark park = {{rates[0], rates[1], rates[2]}, capacity,
+    strlen(name)};
+    size_t padding_size = journal_align(park.name_length) - park.name_length;
+    record.checksum = journal_checksum(journal_checksum(journal_checksum(
+    event_checksum(&record, NULL, 0), &park, sizeof(park)), name,
+    park.name_length), padding, padding_size);
+    append_bytes(&record, sizeof(record));
+    append_bytes(&park, sizeof(park));
+    append_bytes(name, park.name_length);
+    append_bytes(padding, padding_size);
+    end_event();
+}
+
+/**
+ * Records a vehicle's entry, a vehicle's exit or the removal of a park.
+ * @param type the command that made the change: e, s or r
+ * @param park_id the id of the parking lot
+ * @param plate the vehicle's packed plate or NO_PLATE for a removal
+ * @param timestamp the date and time of the entry or exit
+ */
+void journal_event(char type, int park_id, PlateKey plate,
+Timestamp timestamp) {
+    journal.sequence++;
+    if (journal.fd == -1)
+        return;
+    JournalRecord record = {timestamp, plate, park_id, 0, type, {0}};
+    record.checksum = event_checksum(&record, NULL, 0);
+    append_bytes(&record, sizeof(record));
+    end_event();
+}
+
+/**
+ * Takes the next record of a journal being read.
+ * @param reader the journal reader
+ * @param size the size of the record, which is followed by padding
+ * @return the record or NULL if the journal ends before it
+ */
+static const void *take(JournalReader *reader, size_t size) {
+    size_t aligned = journal_align(size);
+    if (aligned < size || aligned > reader->size - reader->position)
+        return NULL;
+    const void *record = reader->data + reader->position;
+    reader->position += aligned;
+    return record;
+}
+
+/**
+ * Reads the next event of a journal and checks that it is whole.
+ * @param reader the journal reader
+ * @param park where the payload of command p is stored
+ * @return the event's record or NULL if the journal ends before a whole
+ * event
+ */
+static const JournalRecord *next_event(JournalReader *reader,
+const JournalPark **park) {
+    const JournalRecord *record = take(reader, sizeof(JournalRecord));
+    if (record == NULL)
+        return NULL;
+    size_t start = reader->position;
+    *park = NULL;
+    if (record->type == 'p') {
+        *park = take(reader, sizeof(JournalPark));
+        if (*park == NULL || (*park)->name_length <= 0 ||
+        take(reader, (*park)->name_length) == NULL)
+            return NULL;
+    }
+    if (record->checksum != event_checksum(record, reader->data + start,
+    reader->position - start))
+        return NULL;
+    return record;
+}
+
+/**
+ * Gets a parking lot named by an event.
+ * @param park_id the id of the parking lot
+ * @return the parking lot or NULL if there isn't one with that id
+ */
+static ParkingLot *event_park(int park_id) {
+    if (park_id < 0 || park_id >= count_park_ids())
+        return NULL;
+    return find_park_by_id(park_id);
+}
+
+/**
+ * Creates the parking lot of an event of command p.
+ * @param record the event's record
+ * @param park the event's payload, followed by the park's name
+ * @return 1 if the park got the id it had when the event was recorded,
+ * 0 otherwise
+ */
+static int replay_park(const JournalRecord *record, const JournalPark *park) {
+    char *name = strndup((const char *)(park + 1), park->name_length);
+    Cents rates[3] = {park->rates[0], park->rates[1], park->rates[2]};
+    int unique = find_park_id(name) == -1 && strlen(name) > 0;
+    int id = unique ? add_parking_lot(name, park->capacity, rates)->id : -1;
+    free(name);
+    return id == record->park_id;
+}
+
+/**
+ * Applies an event to the state, as its command would have.
+ * @param record the event's record
+ * @param park the event's payload if it's from command p
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if the event fits the state, 0 otherwise
+ */
+static int replay_event(const JournalRecord *record, const JournalPark *park,
+Timestamp *latest) {
+    ParkingLot *parking_lot = event_park(record->park_id);
+    PlateKey plate = record->plate;
+    if (record->type == 'p')
+        return replay_park(record, park);
+    if (parking_lot == NULL)
+        return 0;
+    if (record->type == 'r') {
+        remove_parking_lot_entry(parking_lot->id);
+        return 1;
+    }
+    if (record->type == 'e' && !park_is_full(parking_lot) &&
+    !is_vehicle_parked(plate)) {
+        update_available_spaces_after_entry(parking_lot);
+        add_entry_to_hash_table(plate, parking_lot, record->timestamp);
+    } else if (record->type == 's' &&
+    is_vehicle_parked_here(parking_lot, plate)) {
+        update_exit_params(parking_lot, plate, record->timestamp);
+    } else {
+        return 0;
+    }
+    *latest = record->timestamp;
+    return 1;
+}
+
+/**
+ * Applies the events of a journal that the state doesn't have yet. Reading
+ * stops at the first event that isn't whole, which was being written when
+ * the program stopped.
+ * @param reader the journal reader, positioned after the header and left
+ * after the last whole event
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if every event fits the state, 0 otherwise
+ */
+static int replay_journal(JournalReader *reader, Timestamp *latest) {
+    size_t end = reader->position;
+    const JournalRecord *record;
+    const JournalPark *park;
+    while ((record = next_event(reader, &park)) != NULL) {
+        if (++reader->sequence > journal.sequence) {
+            if (!replay_event(record, park, latest))
+                return 0;
+            journal.sequence++;
+        }
+        end = reader->position;
+    }
+    reader->position = end;
+    return 1;
+}
+
+/**
+ * Reads a journal file and applies its events the state doesn't have yet.
+ * @param fd the journal file
+ * @param size the size of the file
+ * @param latest where the latest date and time registered is stored
+ * @return the size of the whole events in the journal, 0 if it holds no
+ * events that follow from the state or -1 if it's invalid
+ */
+static off_t recover_journal(int fd, off_t size, Timestamp *latest) {
+    if (size < (off_t)sizeof(JournalHeader))
+        return 0;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return -1;
+    JournalReader reader = {data, size, 0, 0};
+    const JournalHeader *header = take(&reader, sizeof(JournalHeader));
+    off_t end = -1;
+    if (memcmp(header->magic, JOURNAL_MAGIC, 8) == 0 &&
+    header->version == JOURNAL_VERSION &&
+    header->byte_order == JOURNAL_BYTE_ORDER &&
+    header->base >= 0 && header->base <= journal.sequence) {
+        reader.sequence = header->base;
+        if (replay_journal(&reader, latest))
+            end = reader.sequence >= journal.sequence ? reader.position : 0;
+    }
+    munmap(data, size);
+    return end;
+}
+
+/**
+ * Empties the journal, which starts over from the current state. Events in
+ * the buffer are dropped, so the state they lead to must already be saved
+ * in a synced snapshot.
+ * @return 1 if the journal was emptied, 0 otherwise
+ */
+int reset_journal() {
+    JournalHeader header = {JOURNAL_MAGIC, JOURNAL_VERSION,
+    JOURNAL_BYTE_ORDER, journal.sequence};
+    journal.length = 0;
+    journal.pending = 0;
+    return ftruncate(journal.fd, 0) == 0 &&
+    pwrite(journal.fd, &header, sizeof(header), 0) == sizeof(header) &&
+    fsync(journal.fd) == 0 && lseek(journal.fd, 0, SEEK_END) != -1;
+}
+
+/**
+ * Opens the journal, applying the events in it the state doesn't have yet,
+ * and keeps appending the following events to it. A journal whose events
+ * are all in the state already is emptied.
+ * @param path the journal's path, created if it doesn't exist
+ * @param group_size the number of events written out together
+ * @param sync_interval the least number of milliseconds between syncs
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if the journal was opened, 0 if it couldn't be read or doesn't
+ * follow from the state
+ */
+int open_journal(const char *path, int group_size, long sync_interval,
+Timestamp *latest) {
+    struct stat file_stat;
+    journal.fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (journal.fd == -1 || fstat(journal.fd, &file_stat) != 0) {
+        close_journal();
+        return 0;
+    }
+    journal.group_size = group_size;
+    journal.sync_interval = sync_interval;
+    clock_gettime(CLOCK_MONOTONIC, &journal.last_sync);
+    off_t end = recover_journal(journal.fd, file_stat.st_size, latest);
+    if (end > 0 && end < file_stat.st_size)
+        fprintf(stderr, "%s: dropped %lld bytes after the last whole event\n",
+        path, (long long)(file_stat.st_size - end));
+    int opened = end > 0 ? ftruncate(journal.fd, end) == 0 &&
+    lseek(journal.fd, 0, SEEK_END) != -1 : end == 0 && reset_journal();
+    if (!opened)
+        close_journal();
+    return opened;
+}
+
+/**
+ * Writes out and syncs the events left in the buffer and closes the
+ * journal.
+ */
+void close_journal() {
+    commit_journal();
+    if (journal.fd != -1) {
+        fsync(journal.fd);
+        close(journal.fd);
+    }
+    journal.fd = -1;
+}
@@ -0,0 +1,98 @@
+/**
+ * Header file for journal.c
+ * @file journal.h
+ * @author @inesiscosta
+*/
+
+#ifndef JOURNAL
+#define JOURNAL
+
+/*Includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "datetime.h"
+#include "money.h"
+#include "plate.h"
+
+/*Constants*/
+#define JOURNAL_MAGIC "PARKJRNL"
+#define JOURNAL_VERSION 1
+// Written as a number, reads differently on a machine of another endianness
+#define JOURNAL_BYTE_ORDER 0x01020304u
+#define JOURNAL_ALIGNMENT 8
+#define JOURNAL_BUFFER_SIZE (1 << 16)
+// Events written out together unless set with -g <events>
+#define DEFAULT_GROUP_COMMIT 64
+#define MILLISECONDS_PER_SECOND 1000
+#define NANOSECONDS_PER_MILLISECOND 1000000
+
+/*Journal file layout, every record is a multiple of 8 bytes:
+a header followed by one record per event in the order they happened, those
+of command p followed by the park's capacity and rates and then its name.
+The events are numbered from one more than the base in the header.*/
+
+/*Journal Header Structure*/
+typedef struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    int64_t base; // events the state the journal starts from had applied
+} JournalHeader;
+
+/*Journal Record Structure*/
+typedef struct JournalRecord {
+    int64_t timestamp; // e and s
+    PlateKey plate; // e and s, NO_PLATE for p and r
+    int32_t park_id; // the id the park had or, for p, the one given to it
+    uint32_t checksum; // of the record, with this field as 0, and its payload
+    char type; // the command that made the change: p, e, s or r
+    char padding[7];
+} JournalRecord;
+
+/*Journal Park Structure, the payload of command p*/
+typedef struct JournalPark {
+    int64_t rates[3];
+    int32_t capacity;
+    int32_t name_length; // the name follows, padded to 8 bytes
+} JournalPark;
+
+/*Journal Reader Structure*/
+typedef struct JournalReader {
+    const char *data;
+    size_t size;
+    size_t position;
+    int64_t sequence; // number of the last event read
+} JournalReader;
+
+/*Journal Structure*/
+typedef struct Journal {
+    int fd; // -1 when no journal file is kept
+    int group_size; // events written out together
+    long sync_interval; // milliseconds between syncs, 0 to sync every group
+    int pending; // events in the buffer
+    size_t length; // bytes in the buffer
+    int64_t sequence; // events applied to the state, kept even without a file
+    struct timespec last_sync;
+    char buffer[JOURNAL_BUFFER_SIZE]; // events not written out yet
+} Journal;
+
+extern Journal journal;
+
+/*Function Prototypes*/
+int open_journal(const char *path, int group_size, long sync_interval,
+Timestamp *latest);
+void journal_park(int park_id, const char *name, int capacity,
+Cents rates[3]);
+void journal_event(char type, int park_id, PlateKey plate,
+Timestamp timestamp);
+void commit_journal();
+int reset_journal();
+void close_journal();
+#endif
@@ -9,51 +9,168 @@
 #include "parking_lot.h"
 #include "vehicle.h"
 #include "utils.h"
+#include "command.h"
+#include "input.h"
+#include "output.h"
+#include "snapshot.h"
+#include "pipeline.h"
+
+/*Options Structure*/
+typedef struct Options {
+    char *load_path; // snapshot loaded before the first command
+    char *write_path; // snapshot written once the commands end
+    char *journal_path; // journal replayed and then appended to
+    int group_size; // events written out to the journal together
+    int sync_interval; // least milliseconds between syncs of the journal
+    int threaded; // commands read, executed and written in a pipeline
+    int query_workers; // threads running queries in parallel in the pipeline
+    char *commands_path; // NULL to read the commands from stdin
+} Options;
+
+/**
+ * Reads and processes the commands until the input ends or command q. When
+ * the program runs interactively the events of each command are written to
+ * the journal before its output is shown.
+ * @param input the input with the commands
+ * @param latest the latest date and time registered in the system
+ */
+void run_commands(InputReader *input, Timestamp *latest) {
+    char *line;
+    while ((line = read_line(input)) != NULL &&
+    process_command(line, latest)) {
+        if (is_output_interactive()) {
+            commit_journal();
+            flush_output();
+        }
+    }
+    commit_journal();
+    flush_output();
+}
+
+/**
+ * Processes the commands, in a pipeline of threads if asked to and the
+ * program isn't running interactively.
+ * @param options the program's options
+ * @param input the input with the commands
+ * @param latest the latest date and time registered in the system
+ */
+void process_input(Options *options, InputReader *input, Timestamp *latest) {
+    if (options->threaded && !is_output_interactive() &&
+    run_pipeline(input, latest, options->query_workers))
+        commit_journal();
+    else
+        run_commands(input, latest);
+}
+
+/**
+ * Reads the options given to the program.
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @param options where the options are stored
+ * @return 1 if the options are valid, 0 otherwise
+ */
+int parse_options(int argc, char *argv[], Options *options) {
+    int option, valid = 1;
+    while (valid && (option = getopt(argc, argv, "l:w:j:g:s:tq:")) != -1) {
+        if (option == 'l')
+            options->load_path = optarg;
+        else if (option == 'w')
+            options->write_path = optarg;
+        else if (option == 'j')
+            options->journal_path = optarg;
+        else if (option == 'g')
+            valid = parse_integer(optarg, &options->group_size) &&
+            options->group_size > 0;
+        else if (option == 's')
+            valid = parse_integer(optarg, &options->sync_interval) &&
+            options->sync_interval >= 0;
+        else if (option == 't')
+            options->threaded = 1;
+        else if (option == 'q')
+            valid = parse_integer(optarg, &options->query_workers) &&
+            options->query_workers >= 0;
+        else
+            valid = 0;
+    }
+    if (!valid)
+        return 0;
+    // Queries are only run in parallel by the pipeline
+    if (options->query_workers > 0)
+        options->threaded = 1;
+    options->commands_path = optind < argc ? argv[optind] : NULL;
+    return 1;
+}
 
 /**
- * Function to process a single command.
+ * Loads the state saved in the snapshot and the journal given as options.
+ * @param options the program's options
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if the state was loaded, 0 otherwise
  */
-void process_command(char *command, char *latest_date, char *latest_time, char *first_date, int *first_date_set) {
-    switch(command[0]) {
-        case 'p':
-            create_parking_lot(command);
-            break;
-        case 'e':
-            register_vehicle_entry(command, latest_date, latest_time, first_date, (char *)first_date_set);
-            break;
-        case 's':
-            register_vehicle_exit(command, latest_date, latest_time);
-            break;
-        case 'v':
-            list_vehicle_entries_and_exits(command);
-            break;
-        case 'f':
-            list_billings(command, latest_date, latest_time, first_date);
-            break;
-        case 'r':
-            remove_parking_lot(command);
-            break;
-        case 'q':
-            cleanup(command);
-            exit(0);
+int load_state(Options *options, Timestamp *latest) {
+    if (options->load_path != NULL &&
+    !load_snapshot(options->load_path, latest)) {
+        fprintf(stderr, "%s: invalid snapshot\n", options->load_path);
+        return 0;
+    }
+    if (options->journal_path != NULL && !open_journal(options->journal_path,
+    options->group_size, options->sync_interval, latest)) {
+        fprintf(stderr, "%s: invalid journal\n", options->journal_path);
+        return 0;
     }
+    return 1;
 }
 
 /**
- * Main function, reads the commands (p, e, s, v, f, r, q) and
- * calls the appropriate functions.
+ * Saves the state to the snapshot given as option, after which the journal
+ * starts over. The journal is only emptied once the snapshot and its
+ * directory are synced, so a crash in between loses no event.
+ * @param options the program's options
+ * @param latest the latest date and time registered in the system
  */
-int main() {
-    char first_date[DATE_LENGTH] = "01-01-0000";
-    int first_date_set = 0;
-    char latest_date[DATE_LENGTH] = "01-01-0000";
-    char latest_time[TIME_LENGTH] = "00:00";
+void save_state(Options *options, Timestamp latest) {
+    if (options->write_path == NULL)
+        return;
+    if (!write_snapshot(options->write_path, latest))
+        perror(options->write_path);
+    else if (journal.fd != -1 && !reset_journal())
+        perror(options->journal_path);
+}
+
+/**
+ * Main function, reads the commands (p, e, s, v, w, f, r, q) and
+ * calls the appropriate functions. The commands are read from the file given
+ * as argument or from the standard input, and reaching its end is the same as
+ * command q. With -l <snapshot> the state saved in a snapshot is loaded
+ * before the first command and with -w <snapshot> the state is saved once
+ * the commands end. With -j <journal> the changes are also appended to a
+ * journal, -g <events> at a time and syncing it at most every
+ * -s <milliseconds>, and the changes in it are recovered on start. With -t
+ * reading, executing and writing run in threads of their own, and with
+ * -q <workers> runs of queries are also spread over that many threads.
+ */
+int main(int argc, char *argv[]) {
+    Options options = {NULL, NULL, NULL, DEFAULT_GROUP_COMMIT, 0, 0, 0,
+    NULL};
+    InputReader input;
+    if (!parse_options(argc, argv, &options))
+        return 1;
+    if (!open_input(&input, options.commands_path)) {
+        perror(options.commands_path);
+        return 1;
+    }
+    // 01-01-0000 00:00
+    Timestamp latest = 0;
     initialize_hash_table();
-    while (1) {
-        char *command = malloc(BUFSIZ * sizeof(char));
-        fgets(command, BUFSIZ, stdin);
-        command = realloc(command, strlen(command) + 1);
-        process_command(command, latest_date, latest_time, first_date, &first_date_set);
-        free(command);
+    initialize_output();
+    int loaded = load_state(&options, &latest);
+    if (loaded) {
+        process_input(&options, &input, &latest);
+        save_state(&options, latest);
+        STATS_DUMP();
     }
-}
\ No newline at end of file
+    close_journal();
+    cleanup();
+    close_input(&input);
+    return !loaded;
+}
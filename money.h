@@ -0,0 +1,15 @@
+/**
+ * Header file with the representation of money in the park management system.
+ * @file money.h
+ * @author @inesiscosta
+*/
+
+#ifndef MONEY
+#define MONEY
+
+/*Constants*/
+#define CENTS_PER_EURO 100
+
+/*Amounts of money are whole numbers of cents, so that sums are exact*/
+typedef long long Cents;
+#endif
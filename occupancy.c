@@ -0,0 +1,122 @@
+/**
+ * File containing the log of the entries and exits of a park, which answers
+ * how many vehicles were parked there at any past instant. Every so many
+ * events the log keeps the number of vehicles parked before that event, so
+ * an answer is a binary search for the instant followed by the replay of
+ * the few events since the checkpoint before it.
+ * @file occupancy.c
+ * @author @inesiscosta
+ */
+
+#include "occupancy.h"
+
+/**
+ * Initializes an empty log.
+ * @param log the log to be initialized
+ */
+void occupancy_log_init(OccupancyLog *log) {
+    log->events = NULL;
+    log->num_events = 0;
+    log->capacity = 0;
+    log->checkpoints = NULL;
+    log->occupancy = 0;
+}
+
+/**
+ * Frees the events and checkpoints of the log.
+ * @param log the log
+ */
+void occupancy_log_free(OccupancyLog *log) {
+    free(log->events);
+    free(log->checkpoints);
+    occupancy_log_init(log);
+}
+
+/**
+ * Appends an event to the log, keeping a checkpoint before it if it starts
+ * a new run of CHECKPOINT_EVENTS events.
+ * @param log the log
+ * @param time the date and time of the event, not before the last event's
+ * unless the log is sorted afterwards
+ * @param entry 1 if the event is an entry, 0 if it is an exit
+ */
+void log_occupancy_event(OccupancyLog *log, Timestamp time, int entry) {
+    if (log->num_events == log->capacity) {
+        log->capacity = log->capacity == 0 ?
+        INITIAL_OCCUPANCY_EVENTS : log->capacity * 2;
+        STATS_COUNT(allocations);
+        log->events = (Timestamp *)realloc(log->events,
+        log->capacity * sizeof(Timestamp));
+        STATS_COUNT(allocations);
+        log->checkpoints = (int *)realloc(log->checkpoints,
+        (log->capacity >> CHECKPOINT_SHIFT) * sizeof(int));
+    }
+    if ((log->num_events & (CHECKPOINT_EVENTS - 1)) == 0)
+        log->checkpoints[log->num_events >> CHECKPOINT_SHIFT] =
+        log->occupancy;
+    log->events[log->num_events++] = time * 2 + entry;
+    log->occupancy += entry ? 1 : -1;
+}
+
+/**
+ * Compares two events of a log, to be used with qsort.
+ * @param event1 pointer to the first event
+ * @param event2 pointer to the second event
+ * @return a negative integer, 0 or a positive integer if the first event is
+ * respectively earlier than, at the same time as or later than the second
+ */
+static int compare_events(const void *event1, const void *event2) {
+    Timestamp first = *(const Timestamp *)event1;
+    Timestamp second = *(const Timestamp *)event2;
+    return (first > second) - (first < second);
+}
+
+/**
+ * Sorts a log whose events were appended out of order, as when restoring a
+ * park, and computes its checkpoints again.
+ * @param log the log
+ */
+void sort_occupancy_log(OccupancyLog *log) {
+    qsort(log->events, log->num_events, sizeof(Timestamp), compare_events);
+    log->occupancy = 0;
+    for (int i = 0; i < log->num_events; i++) {
+        if ((i & (CHECKPOINT_EVENTS - 1)) == 0)
+            log->checkpoints[i >> CHECKPOINT_SHIFT] = log->occupancy;
+        log->occupancy += (log->events[i] & 1) ? 1 : -1;
+    }
+}
+
+/**
+ * Counts the vehicles that were parked at a given instant, after the
+ * entries and exits registered at that instant.
+ * @param log the log
+ * @param time the date and time
+ * @return the number of vehicles parked at that time
+ */
+int occupancy_at(const OccupancyLog *log, Timestamp time) {
+    // Ends as the number of events up to the given time
+    int low = 0, high = log->num_events;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (log->events[middle] < (time + 1) * 2)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == log->num_events)
+        return log->occupancy;
+    int occupancy = log->checkpoints[low >> CHECKPOINT_SHIFT];
+    for (int i = low & ~(CHECKPOINT_EVENTS - 1); i < low; i++)
+        occupancy += (log->events[i] & 1) ? 1 : -1;
+    return occupancy;
+}
+
+/**
+ * Gets the memory taken by the log.
+ * @param log the log
+ * @return the number of bytes reserved for the log
+ */
+size_t occupancy_log_bytes(const OccupancyLog *log) {
+    return log->capacity * sizeof(Timestamp) +
+    (log->capacity >> CHECKPOINT_SHIFT) * sizeof(int);
+}
@@ -0,0 +1,38 @@
+/**
+ * Header file for occupancy.c
+ * @file occupancy.h
+ * @author @inesiscosta
+*/
+
+#ifndef OCCUPANCY
+#define OCCUPANCY
+
+/*Includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "datetime.h"
+#include "stats.h"
+
+/*Constants*/
+// Events between two checkpoints of the occupancy, a power of 2
+#define CHECKPOINT_EVENTS 64
+#define CHECKPOINT_SHIFT 6
+#define INITIAL_OCCUPANCY_EVENTS CHECKPOINT_EVENTS
+
+/*Occupancy Log Structure, the entries and exits of a park in order of time*/
+typedef struct OccupancyLog {
+    Timestamp *events; // twice the time of each event, plus 1 for entries
+    int num_events;
+    int capacity;
+    int *checkpoints; // vehicles parked before every CHECKPOINT_EVENTS-th event
+    int occupancy; // vehicles parked after the last event
+} OccupancyLog;
+
+/*Function Prototypes*/
+void occupancy_log_init(OccupancyLog *log);
+void occupancy_log_free(OccupancyLog *log);
+void log_occupancy_event(OccupancyLog *log, Timestamp time, int entry);
+void sort_occupancy_log(OccupancyLog *log);
+int occupancy_at(const OccupancyLog *log, Timestamp time);
+size_t occupancy_log_bytes(const OccupancyLog *log);
+#endif
@@ -0,0 +1,330 @@
+/**
+ * File containing the output buffer of the park management system.
+ * Everything the program prints is formatted by hand into one buffer, which
+ * is only written out when it fills up, when the program ends or, if the
+ * output is a terminal, after each command. Full blocks can also be handed
+ * to a writer thread, so that the program doesn't wait for them to be
+ * written. Every thread has a buffer of its own, and the output of threads
+ * other than the main one is captured in memory to be written out in order.
+ * @file output.c
+ * @author @inesiscosta
+ */
+
+#include "output.h"
+
+static OutputBlock blocks[OUTPUT_BLOCKS];
+_Thread_local OutputBuffer output = {blocks[0].data, 0, &blocks[0], NULL};
+static OutputWriter writer = {0, 0, {0}, {0}, 0};
+
+/**
+ * Sets up the output buffer, in interactive mode if the output is a terminal.
+ */
+void initialize_output() {
+    output.length = 0;
+    writer.interactive = isatty(STDOUT_FILENO);
+}
+
+/**
+ * Gives the calling thread, which isn't the main one, a buffer of its own.
+ */
+void initialize_thread_output() {
+    output.block = (OutputBlock *)malloc(sizeof(OutputBlock));
+    output.data = output.block->data;
+    output.length = 0;
+    output.capture = NULL;
+}
+
+/**
+ * Frees the buffer of the calling thread, which isn't the main one.
+ */
+void free_thread_output() {
+    free(output.block);
+    output.block = NULL;
+    output.data = NULL;
+}
+
+/**
+ * Writes bytes to the standard output.
+ * @param data the bytes
+ * @param length the number of bytes
+ */
+static void write_block(const char *data, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t bytes = write(STDOUT_FILENO, data + written,
+        length - written);
+        if (bytes <= 0)
+            break;
+        written += bytes;
+    }
+}
+
+/**
+ * Moves everything in the output buffer to the end of the capture.
+ */
+static void capture_output() {
+    OutputCapture *capture = output.capture;
+    size_t needed = capture->length + output.length;
+    if (output.length == 0)
+        return;
+    if (needed > capture->capacity) {
+        if (capture->capacity == 0)
+            capture->capacity = INITIAL_CAPTURE_CAPACITY;
+        while (capture->capacity < needed)
+            capture->capacity *= 2;
+        capture->data = (char *)realloc(capture->data, capture->capacity);
+    }
+    memcpy(capture->data + capture->length, output.data, output.length);
+    capture->length += output.length;
+}
+
+/**
+ * Writes out everything in the output buffer, hands it to the writer thread
+ * and carries on in a free block or, while capturing, keeps it in memory.
+ */
+void flush_output() {
+    if (output.capture != NULL) {
+        capture_output();
+    } else if (writer.threaded) {
+        output.block->length = output.length;
+        ring_push(&writer.written, output.block);
+        output.block = ring_pop(&writer.free_blocks);
+        output.data = output.block->data;
+    } else {
+        write_block(output.data, output.length);
+    }
+    output.length = 0;
+}
+
+/**
+ * Writes out the blocks handed to the writer thread, in order, until the
+ * ring of written blocks is closed.
+ * @param argument unused
+ * @return NULL
+ */
+static void *write_blocks(void *argument) {
+    OutputBlock *block;
+    (void)argument;
+    while ((block = ring_pop(&writer.written)) != NULL) {
+        write_block(block->data, block->length);
+        ring_push(&writer.free_blocks, block);
+    }
+    return NULL;
+}
+
+/**
+ * Starts a thread that writes out the output of the main thread, each block
+ * as soon as it fills up.
+ * @return 1 if the thread was started, 0 if the output is still written
+ * directly
+ */
+int start_output_writer() {
+    ring_init(&writer.written, OUTPUT_BLOCKS);
+    ring_init(&writer.free_blocks, OUTPUT_BLOCKS);
+    for (int i = 0; i < OUTPUT_BLOCKS; i++)
+        if (&blocks[i] != output.block)
+            ring_push(&writer.free_blocks, &blocks[i]);
+    writer.threaded = pthread_create(&writer.thread, NULL, write_blocks,
+    NULL) == 0;
+    if (!writer.threaded) {
+        ring_free(&writer.written);
+        ring_free(&writer.free_blocks);
+    }
+    return writer.threaded;
+}
+
+/**
+ * Hands what is left in the buffer to the writer thread and waits for it to
+ * write everything out, after which the output is written directly again.
+ */
+void stop_output_writer() {
+    if (!writer.threaded)
+        return;
+    if (output.length > 0)
+        flush_output();
+    ring_close(&writer.written);
+    pthread_join(writer.thread, NULL);
+    writer.threaded = 0;
+    ring_free(&writer.written);
+    ring_free(&writer.free_blocks);
+}
+
+/**
+ * Starts keeping the output of the calling thread in memory.
+ * @param capture where the output is kept, emptied first
+ */
+void start_capture(OutputCapture *capture) {
+    capture->length = 0;
+    output.capture = capture;
+}
+
+/**
+ * Moves what is left in the buffer to the capture and stops capturing.
+ */
+void stop_capture() {
+    flush_output();
+    output.capture = NULL;
+}
+
+/**
+ * Checks whether the program is running interactively.
+ * @return 1 if the output is flushed after every command, 0 otherwise
+ */
+int is_output_interactive() {
+    return writer.interactive;
+}
+
+/**
+ * Makes sure the output buffer has room for some bytes.
+ * @param length the number of bytes about to be written
+ */
+static void reserve_output(size_t length) {
+    if (output.length + length > OUTPUT_BUFFER_SIZE)
+        flush_output();
+}
+
+/**
+ * Writes a character.
+ * @param character the character
+ */
+void write_char(char character) {
+    reserve_output(1);
+    output.data[output.length++] = character;
+}
+
+/**
+ * Writes bytes, in pieces if they don't fit in the buffer.
+ * @param data the bytes
+ * @param length the number of bytes
+ */
+void write_bytes(const char *data, size_t length) {
+    while (length > 0) {
+        if (output.length == OUTPUT_BUFFER_SIZE)
+            flush_output();
+        size_t chunk = OUTPUT_BUFFER_SIZE - output.length;
+        if (chunk > length)
+            chunk = length;
+        memcpy(output.data + output.length, data, chunk);
+        output.length += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+/**
+ * Writes a string.
+ * @param text the string
+ */
+void write_string(const char *text) {
+    write_bytes(text, strlen(text));
+}
+
+/**
+ * Writes a string followed by a newline.
+ * @param text the string
+ */
+void write_line(const char *text) {
+    write_string(text);
+    write_char('\n');
+}
+
+/**
+ * Writes an error message line.
+ * @param message the message
+ */
+void write_error(const char *message) {
+    STATS_ERROR();
+    write_line(message);
+}
+
+/**
+ * Writes an error message line in the format "<subject>: <message>".
+ * @param subject what the message is about, such as a park or a plate
+ * @param message the message
+ */
+void write_message(const char *subject, const char *message) {
+    write_string(subject);
+    write_string(": ");
+    write_error(message);
+}
+
+/**
+ * Writes a non negative number with at least a given number of digits,
+ * padded with zeros on the left.
+ * @param value the number
+ * @param width the minimum number of digits
+ */
+static void write_padded(unsigned long long value, int width) {
+    char digits[MAX_NUMBER_LENGTH];
+    int length = 0;
+    do {
+        digits[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0 || length < width);
+    reserve_output(length);
+    while (length > 0)
+        output.data[output.length++] = digits[--length];
+}
+
+/**
+ * Writes a whole number.
+ * @param value the number
+ */
+void write_integer(long long value) {
+    if (value < 0) {
+        write_char('-');
+        write_padded(0ULL - (unsigned long long)value, 1);
+    } else {
+        write_padded(value, 1);
+    }
+}
+
+/**
+ * Writes an amount of money with two decimal places.
+ * @param value the amount in cents
+ */
+void write_money(Cents value) {
+    unsigned long long cents = value;
+    if (value < 0) {
+        write_char('-');
+        cents = 0ULL - cents;
+    }
+    write_padded(cents / CENTS_PER_EURO, 1);
+    write_char('.');
+    write_padded(cents % CENTS_PER_EURO, 2);
+}
+
+/**
+ * Writes a date in the format DD-MM-AAAA.
+ * @param day_number the number of days elapsed since 01-01-0000
+ */
+void write_date(int day_number) {
+    int day, month, year;
+    split_date(day_number, &day, &month, &year);
+    write_padded(day, 2);
+    write_char('-');
+    write_padded(month, 2);
+    write_char('-');
+    write_padded(year, 4);
+}
+
+/**
+ * Writes the time of the day of a timestamp in the format HH:MM.
+ * @param timestamp the timestamp
+ */
+void write_time(Timestamp timestamp) {
+    int minutes = (int)(timestamp % MINUTES_PER_DAY);
+    write_padded(minutes / MINUTES_PER_HOUR, 2);
+    write_char(':');
+    write_padded(minutes % MINUTES_PER_HOUR, 2);
+}
+
+/**
+ * Writes the date and the time of a timestamp separated by a space.
+ * @param timestamp the timestamp
+ */
+void write_datetime(Timestamp timestamp) {
+    write_date(timestamp_day(timestamp));
+    write_char(' ');
+    write_time(timestamp);
+}
@@ -0,0 +1,79 @@
+/**
+ * Header file for output.c
+ * @file output.h
+ * @author @inesiscosta
+*/
+
+#ifndef OUTPUT
+#define OUTPUT
+
+/*Includes*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "datetime.h"
+#include "money.h"
+#include "stats.h"
+#include "ring.h"
+
+/*Constants*/
+#define OUTPUT_BUFFER_SIZE (1 << 16)
+// Longest text written at once by the number formatters
+#define MAX_NUMBER_LENGTH 24
+// Blocks filled or being written at once with a writer thread, a power of 2
+#define OUTPUT_BLOCKS 4
+#define INITIAL_CAPTURE_CAPACITY 256
+
+/*Output Block Structure*/
+typedef struct OutputBlock {
+    char data[OUTPUT_BUFFER_SIZE];
+    size_t length;
+} OutputBlock;
+
+/*Output Capture Structure, output kept in memory instead of written out*/
+typedef struct OutputCapture {
+    char *data;
+    size_t length;
+    size_t capacity;
+} OutputCapture;
+
+/*Output Buffer Structure, each thread fills its own*/
+typedef struct OutputBuffer {
+    char *data; // data of the block being filled
+    size_t length;
+    OutputBlock *block; // block being filled
+    OutputCapture *capture; // where flushed output goes instead, if set
+} OutputBuffer;
+
+/*Output Writer Structure*/
+typedef struct OutputWriter {
+    int interactive; // flushed after every command when set
+    int threaded; // full blocks are written by the writer thread when set
+    Ring written; // full blocks waiting for the writer thread
+    Ring free_blocks; // blocks the writer thread is done with
+    pthread_t thread;
+} OutputWriter;
+
+/*Function Prototypes*/
+void initialize_output();
+void flush_output();
+int is_output_interactive();
+int start_output_writer();
+void stop_output_writer();
+void initialize_thread_output();
+void free_thread_output();
+void start_capture(OutputCapture *capture);
+void stop_capture();
+void write_bytes(const char *data, size_t length);
+void write_char(char character);
+void write_string(const char *text);
+void write_line(const char *text);
+void write_error(const char *message);
+void write_message(const char *subject, const char *message);
+void write_integer(long long value);
+void write_money(Cents value);
+void write_date(int day_number);
+void write_time(Timestamp timestamp);
+void write_datetime(Timestamp timestamp);
+#endif
@@ -9,88 +9,281 @@
 #include "parking_lot.h"
 
 
-ParkingLot parking_lots[MAX_PARKS]; // Array of ParkingLots
+// ParkingLots indexed by their id, NULL once removed so that a removed park
+// only keeps its slot in the arrays indexed by id
+ParkingLot **parking_lots = NULL;
+int parks_capacity = 0; // Number of ids the arrays indexed by id can hold
+int next_park_id = 0; // Number of ids given out, removed parks included
 int num_parks = 0; // Current number of parking lots in the system
+// Ids of the existing parks in order of creation, so that going over the
+// parks doesn't cost anything for the removed ones
+int *live_park_ids = NULL;
+// Position of each existing park's name among the names in alphabetical
+// order, indexed by id and kept apart from the parks so it stays in cache
+int *park_ranks = NULL;
+ParkDirectory park_directory = {NULL, 0, 0}; // Maps names to park ids
 
 /**
- * Frees the memory allocated for command, hash_table and parking lot names.
- * @param command the command to be freed
+ * Initializes the empty records of the stays of a new parking lot: its
+ * ledger, columns, occupancy log, rankings and parked vehicles.
+ * @param parking_lot the parking lot
  */
-void cleanup(char *command) {
-    free(command);
-    for (int i = 0; i < num_parks; i++)
-        free(parking_lots[i].name);
+static void init_park_stays(ParkingLot *parking_lot) {
+    parking_lot->ledger = NULL;
+    parking_lot->ledger_size = 0;
+    parking_lot->ledger_capacity = 0;
+    stay_columns_init(&parking_lot->closed);
+    occupancy_log_init(&parking_lot->occupancy);
+    top_stays_init(&parking_lot->highest_totals);
+    top_stays_init(&parking_lot->longest_stays);
+    arena_init(&parking_lot->stays);
+    parking_lot->parked = NULL;
+    parking_lot->free_stays = NULL;
+}
+
+/**
+ * Frees the records of the stays of a parking lot, leaving them empty.
+ * @param parking_lot the parking lot
+ */
+static void free_park_stays(ParkingLot *parking_lot) {
+    free_ledger(parking_lot);
+    stay_columns_free(&parking_lot->closed);
+    occupancy_log_free(&parking_lot->occupancy);
+    arena_free(&parking_lot->stays);
+    init_park_stays(parking_lot);
+}
+
+/**
+ * Frees the memory allocated for the hash_table and parking lots.
+ */
+void cleanup() {
+    for (int position = 0; position < num_parks; position++) {
+        ParkingLot *parking_lot = find_park_by_position(position);
+        free(parking_lot->name);
+        free_park_stays(parking_lot);
+        free(parking_lot);
+    }
+    free(parking_lots);
+    free(live_park_ids);
+    free(park_ranks);
+    free(park_directory.slots);
     free_hash_table();
 }
 
 /**
- * Searches within the array parking_lots for a ParkingLot
- * with the name provided.
+ * Searches the park directory for the slot holding a park's id.
+ * @param name the name of the parking lot
+ * @return the slot with the park's id or NULL if no park has that name
+ */
+static int *find_directory_slot(char *name) {
+    if (park_directory.capacity == 0)
+        return NULL;
+    int mask = park_directory.capacity - 1;
+    STATS_COUNT(directory_lookups);
+    for (int i = hash_function(name) & mask;
+    park_directory.slots[i] != PARK_SLOT_EMPTY; i = (i + 1) & mask) {
+        STATS_COUNT(directory_probe_steps);
+        int id = park_directory.slots[i];
+        if (id >= 0 && strcmp(parking_lots[id]->name, name) == 0)
+            return &park_directory.slots[i];
+    }
+    return NULL;
+}
+
+/**
+ * Stores a park's id in the first free slot of its name's probe sequence.
+ * @param id the id of a park whose name isn't in the directory
+ */
+static void add_directory_slot(int id) {
+    int mask = park_directory.capacity - 1;
+    int i = hash_function(parking_lots[id]->name) & mask;
+    while (park_directory.slots[i] >= 0)
+        i = (i + 1) & mask;
+    if (park_directory.slots[i] == PARK_SLOT_EMPTY)
+        park_directory.used++;
+    park_directory.slots[i] = id;
+}
+
+/**
+ * Rebuilds the park directory with enough slots for the existing parks plus
+ * one more at a load factor of at most 1/2, dropping deleted slots.
+ */
+static void grow_park_directory() {
+    int capacity = INITIAL_DIRECTORY_CAPACITY;
+    while ((num_parks + 1) * 2 > capacity)
+        capacity *= 2;
+    free(park_directory.slots);
+    STATS_COUNT(allocations);
+    park_directory.slots = (int *)malloc(capacity * sizeof(int));
+    for (int i = 0; i < capacity; i++)
+        park_directory.slots[i] = PARK_SLOT_EMPTY;
+    park_directory.capacity = capacity;
+    park_directory.used = 0;
+    for (int position = 0; position < num_parks; position++)
+        add_directory_slot(live_park_ids[position]);
+}
+
+/**
+ * Gives out the id of a new park, growing the array of parking lots and the
+ * park directory if needed.
+ * @return the new park's id
+ */
+static int allocate_park_id() {
+    if (next_park_id == parks_capacity) {
+        parks_capacity = parks_capacity == 0 ?
+        INITIAL_PARKS_CAPACITY : parks_capacity * 2;
+        STATS_COUNT(allocations);
+        parking_lots = realloc(parking_lots,
+        parks_capacity * sizeof(ParkingLot *));
+        STATS_COUNT(allocations);
+        live_park_ids = realloc(live_park_ids, parks_capacity * sizeof(int));
+        STATS_COUNT(allocations);
+        park_ranks = realloc(park_ranks, parks_capacity * sizeof(int));
+    }
+    if ((park_directory.used + 1) * 4 > park_directory.capacity * 3)
+        grow_park_directory();
+    return next_park_id++;
+}
+
+/**
+ * Finds the id of the parking lot with the name provided.
+ * @param name the name of the parking_lot
+ * @return the park's id or -1 if no park has the given name
+ */
+int find_park_id(char *name) {
+    int *slot = find_directory_slot(name);
+    return slot != NULL ? *slot : -1;
+}
+
+/**
+ * Gets the ParkingLot with the given id.
+ * @param id an id that was given out
+ * @return the parking lot with that id or NULL if it was removed
+ */
+ParkingLot *find_park_by_id(int id) {
+    return parking_lots[id];
+}
+
+/**
+ * Gets the number of existing parking lots.
+ * @return the number of parking lots
+ */
+int count_parks() {
+    return num_parks;
+}
+
+/**
+ * Gets an existing ParkingLot by its position in order of creation.
+ * @param position the position, from 0 to the number of parking lots
+ * @return the parking lot at that position
+ */
+ParkingLot *find_park_by_position(int position) {
+    return parking_lots[live_park_ids[position]];
+}
+
+/**
+ * Gets the alphabetical position of an existing park's name, so that names
+ * can be ordered without being read.
+ * @param id the id of an existing parking lot
+ * @return the number of existing parks whose names come before its name
+ */
+int park_name_rank(int id) {
+    return park_ranks[id];
+}
+
+/**
+ * Moves the ranks of the existing parks whose names come after a park's.
+ * @param id the id of the park, whose rank is already set
+ * @param shift 1 when the park is added, -1 when it is removed
+ */
+static void shift_park_ranks(int id, int shift) {
+    for (int position = 0; position < num_parks; position++) {
+        int other = live_park_ids[position];
+        if (other != id && park_ranks[other] >= park_ranks[id])
+            park_ranks[other] += shift;
+    }
+}
+
+/**
+ * Gets the number of park ids given out so far, removed parks included.
+ * @return one more than the highest park id
+ */
+int count_park_ids() {
+    return next_park_id;
+}
+
+/**
+ * Searches the park directory for a ParkingLot with the name provided.
  * @param name the name of the parking_lot
  * @return ParkingLot* if park with the given name is found, otherwise NULL
  */
 ParkingLot *find_park_by_name(char *name) {
-    for (int i = 0; i < num_parks; i++)
-        if (strcmp(parking_lots[i].name, name) == 0)
-            return &parking_lots[i];
-    return NULL;
+    int id = find_park_id(name);
+    return id != -1 ? parking_lots[id] : NULL;
 }
 
 /**
  * Lists the parking lots.
  */
 void list_parking_lots() {
-    for (int i = 0; i < num_parks; i++) {
-        printf("%s %d %d\n", parking_lots[i].name, 
-        parking_lots[i].capacity, parking_lots[i].available_spaces);
+    for (int position = 0; position < num_parks; position++) {
+        ParkingLot *parking_lot = find_park_by_position(position);
+        write_string(parking_lot->name);
+        write_char(' ');
+        write_integer(parking_lot->capacity);
+        write_char(' ');
+        write_integer(parking_lot->available_spaces);
+        write_char('\n');
     }
 }
 
 /**
  * Checks whether the given park is full (doesn't have empty spaces).
- * @param name the name of the parking lot
- * @return 1 if park exists and is full, 0 otherwise 
+ * @param parking_lot the parking lot
+ * @return 1 if park is full, 0 otherwise 
  */
-int park_is_full(char *name) {
-    ParkingLot *parking_lot = find_park_by_name(name);
-    return (parking_lot != NULL && parking_lot->available_spaces == 0);
+int park_is_full(ParkingLot *parking_lot) {
+    return parking_lot->available_spaces == 0;
 }
 
 /**
- * Calculates the amount of money made due to a vehicle's stay in the park
- * @param parking_lot the name of the parking lot the vehicle parked in
- * @param entry_date the date the vehicle entered the parking lot
- * @param entry_time the time the vehicle entered the parking lot
- * @param exit_date the date the vehicle exited the parking lot
- * @param exit_time the time the vehicle exited the parking lot
+ * Fills the tariff of a parking lot with the cost of a stay shorter than a
+ * day for every number of started quarter hours, already capped at the max
+ * daily cost.
+ * @param parking_lot the parking lot, with its rates set
+ */
+void build_tariff(ParkingLot *parking_lot) {
+    for (int slots = 0; slots < TARIFF_SLOTS; slots++) {
+        Cents cost = slots <= QUARTER_HOURS_IN_FIRST_HOUR ?
+        slots * parking_lot->quarter_hourly_rate :
+        QUARTER_HOURS_IN_FIRST_HOUR * parking_lot->quarter_hourly_rate +
+        (slots - QUARTER_HOURS_IN_FIRST_HOUR) *
+        parking_lot->quarter_hourly_rate_after_first_hour;
+        parking_lot->tariff[slots] = cost < parking_lot->max_daily_cost ?
+        cost : parking_lot->max_daily_cost;
+    }
+}
+
+/**
+ * Calculates the amount of money made due to a vehicle's stay in the park:
+ * the max daily cost for every full day plus the cost of the remaining
+ * started quarter hours, taken from the park's tariff.
+ * @param parking_lot the parking lot the vehicle parked in
+ * @param entry the date and time the vehicle entered the parking lot
+ * @param exit the date and time the vehicle exited the parking lot
  * @return return the amount of money made by the parking lot with this
  * entry/exit pair
  */
-float calculate_parking_fee(ParkingLot *parking_lot, char *entry_date,
-char *entry_time, char *exit_date, char *exit_time) {
-    int entry_total_minutes = calculate_total_minutes(entry_date, entry_time);
-    int exit_total_minutes = calculate_total_minutes(exit_date, exit_time);
-    int total_minutes_difference = exit_total_minutes - entry_total_minutes;
-    float fee = 0.0;
-    int num_24_hour_periods = total_minutes_difference / (24 * 60);
-    int remaining_minutes = total_minutes_difference % (24 * 60);
-    fee += num_24_hour_periods * parking_lot->max_daily_cost;
-    /* 16 mins counts as 2 * 15 min slots and division always rounds down,
-    so we add 14 minutes to make sure we round up*/
-    int num_quarter_hour_slots = (remaining_minutes + 14) / 15;
-    if (num_quarter_hour_slots <= 4) {
-        fee += num_quarter_hour_slots * parking_lot->quarter_hourly_rate;
-    } else {
-        // Applying the first hour "discount"
-        fee += 4 * parking_lot->quarter_hourly_rate;
-        remaining_minutes -= 60;
-        // Same as before with the 14 min rounding up
-        fee += ((remaining_minutes + 14) / 15) * 
-        parking_lot->quarter_hourly_rate_after_first_hour;
-    } 
-    if (fee > parking_lot->max_daily_cost * (num_24_hour_periods + 1))
-        fee = parking_lot->max_daily_cost * (num_24_hour_periods + 1);
-    return fee;
+Cents calculate_parking_fee(ParkingLot *parking_lot, Timestamp entry,
+Timestamp exit) {
+    Timestamp duration = exit - entry;
+    Timestamp full_days = duration / MINUTES_PER_DAY;
+    int remaining_minutes = (int)(duration % MINUTES_PER_DAY);
+    // A started quarter hour is paid in full
+    int slots = (remaining_minutes + MINUTES_PER_QUARTER_HOUR - 1) /
+    MINUTES_PER_QUARTER_HOUR;
+    return full_days * parking_lot->max_daily_cost +
+    parking_lot->tariff[slots];
 }
 
 /**
@@ -105,147 +298,503 @@ char *entry_time, char *exit_date, char *exit_time) {
  * @return 0 if park is invalid, 1 otherwise 
  */
 int is_valid_parking_lot(char *name, int capacity,
-float quarter_hourly_rate, float quarter_hourly_rate_after_first_hour, 
-float max_daily_cost) {
-    for (int i = 0; i < num_parks; i++)
-        if (strcmp(parking_lots[i].name, name) == 0) {
-            printf("%s: parking already exists.\n", name);
-            return 0;
-        }
+Cents quarter_hourly_rate, Cents quarter_hourly_rate_after_first_hour, 
+Cents max_daily_cost) {
+    if (find_park_id(name) != -1) {
+        write_message(name, "parking already exists.");
+        return 0;
+    }
     if (num_parks >= MAX_PARKS) {
-        printf("too many parks.\n");
+        write_error("too many parks.");
         return 0;
     }
     if (capacity <= 0) {
-        printf("%d: invalid capacity.\n", capacity);
+        write_integer(capacity);
+        write_error(": invalid capacity.");
         return 0;
     }
     if (quarter_hourly_rate <= 0 || 
         quarter_hourly_rate_after_first_hour <= quarter_hourly_rate || 
         max_daily_cost <= quarter_hourly_rate_after_first_hour) {
-        printf("invalid cost.\n");
+        write_error("invalid cost.");
         return 0;
     }
     return 1;
 }
 
+/**
+ * Extracts the capacity and the rates of a new parking lot from command p.
+ * @param command command p
+ * @param capacity where the capacity is stored
+ * @param rates where the quarter hourly rate, the quarter hourly rate after
+ * the first hour and the max daily cost are stored, in this order
+ * @return 1 if all the arguments were extracted, 0 otherwise
+ */
+static int parse_parking_lot_arguments(Command *command, int *capacity,
+Cents rates[3]) {
+    return command->num_arguments == MAX_ARGUMENTS &&
+    parse_integer(command->arguments[1], capacity) &&
+    parse_cents(command->arguments[2], &rates[0]) &&
+    parse_cents(command->arguments[3], &rates[1]) &&
+    parse_cents(command->arguments[4], &rates[2]);
+}
+
+/**
+ * Adds a parking lot to the array of parking lots and to the park directory.
+ * @param name the parking lot's name, which is copied
+ * @param capacity the parking lot's capacity
+ * @param rates the quarter hourly rate, the quarter hourly rate after the
+ * first hour and the max daily cost, in this order
+ * @return the new parking lot
+ */
+ParkingLot *add_parking_lot(char *name, int capacity, Cents rates[3]) {
+    int id = allocate_park_id();
+    STATS_COUNT(allocations);
+    ParkingLot *parking_lot = (ParkingLot *)malloc(sizeof(ParkingLot));
+    parking_lots[id] = parking_lot;
+    parking_lot->id = id;
+    STATS_COUNT(allocations);
+    parking_lot->name = strdup(name);
+    parking_lot->capacity = capacity;
+    parking_lot->quarter_hourly_rate = rates[0];
+    parking_lot->quarter_hourly_rate_after_first_hour = rates[1];
+    parking_lot->max_daily_cost = rates[2];
+    build_tariff(parking_lot);
+    parking_lot->available_spaces = capacity;
+    init_park_stays(parking_lot);
+    add_directory_slot(id);
+    park_ranks[id] = 0;
+    for (int position = 0; position < num_parks; position++)
+        park_ranks[id] += strcmp(find_park_by_position(position)->name,
+        name) < 0;
+    shift_park_ranks(id, 1);
+    live_park_ids[num_parks++] = id;
+    return parking_lot;
+}
+
 /**
  * Creates a parking lot object and adds it to the array of parking lots.
  * Or lists parking lots if enough arguments can't be extracted from command.
  * @param command command p in form "p <name> <capacity> <quarter_hourly_rate>
  * <quarter_hourly_rate_after_first_hour> <max_daily_cost>" or "p".
  */
-void create_parking_lot(char *command) {
-    char *name = (char *)malloc(BUFSIZ * sizeof(char));
+void create_parking_lot(Command *command) {
     int capacity;
-    float quarter_hourly_rate, quarter_hourly_rate_after_first_hour, 
-    max_daily_cost;
-    if (sscanf(command, "p \"%[^\"]\" %d %f %f %f", name, &capacity, 
-    &quarter_hourly_rate, &quarter_hourly_rate_after_first_hour, 
-    &max_daily_cost) != 5 
-    && sscanf(command, "p %s %d %f %f %f", name, &capacity, 
-    &quarter_hourly_rate, &quarter_hourly_rate_after_first_hour, 
-    &max_daily_cost) != 5) {
+    Cents rates[3];
+    if (!parse_parking_lot_arguments(command, &capacity, rates)) {
         // If not enough arguments are provided, list parking lots
         list_parking_lots();
-        free(name);
         return;
     }
-    name = realloc(name, strlen(name) +1);
-    if (is_valid_parking_lot(name, capacity, quarter_hourly_rate, 
-    quarter_hourly_rate_after_first_hour, max_daily_cost)) {
-        parking_lots[num_parks].name = strdup(name); 
-        parking_lots[num_parks].capacity = capacity;
-        parking_lots[num_parks].quarter_hourly_rate = quarter_hourly_rate;
-        parking_lots[num_parks].quarter_hourly_rate_after_first_hour = 
-        quarter_hourly_rate_after_first_hour;
-        parking_lots[num_parks].max_daily_cost = max_daily_cost;
-        parking_lots[num_parks].available_spaces = capacity;
-        num_parks++;
-    }
-    free(name);
+    char *name = command->arguments[0];
+    if (is_valid_parking_lot(name, capacity, rates[0], rates[1], rates[2]))
+        journal_park(add_parking_lot(name, capacity, rates)->id, name,
+        capacity, rates);
 }
 
 /**
  * Updates the number of available spaces in a ParkingLot after a vehicle's
  * entry.
- * @param name the parking lot's name
- * @param available_spaces the number of available spaces in the parking lot
+ * @param parking_lot the parking lot
+ * @return the number of available spaces left in the parking lot
  */
-void update_available_spaces_after_entry(char *name, int *avalable_spaces) {
-    ParkingLot *parking_lot = find_park_by_name(name);
-    parking_lot->available_spaces--;
-    *avalable_spaces = parking_lot->available_spaces;
+int update_available_spaces_after_entry(ParkingLot *parking_lot) {
+    return --parking_lot->available_spaces;
+}
+
+/**
+ * Gets a stay for a vehicle entering a parking lot, reusing one that ended
+ * if there is any, and adds it to the park's list of parked vehicles.
+ * @param parking_lot the parking lot
+ * @return the stay, whose plate and entry are left to be set
+ */
+Vehicle *allocate_stay(ParkingLot *parking_lot) {
+    Vehicle *stay = parking_lot->free_stays;
+    if (stay != NULL)
+        parking_lot->free_stays = stay->next_in_park;
+    else
+        stay = arena_alloc(&parking_lot->stays, sizeof(Vehicle));
+    stay->park_id = parking_lot->id;
+    stay->prev_in_park = NULL;
+    stay->next_in_park = parking_lot->parked;
+    if (parking_lot->parked != NULL)
+        parking_lot->parked->prev_in_park = stay;
+    parking_lot->parked = stay;
+    return stay;
+}
+
+/**
+ * Takes a stay that ended out of the list of parked vehicles of its parking
+ * lot, keeping it to be reused.
+ * @param parking_lot the parking lot
+ * @param stay the stay
+ */
+static void release_stay(ParkingLot *parking_lot, Vehicle *stay) {
+    if (stay->prev_in_park != NULL)
+        stay->prev_in_park->next_in_park = stay->next_in_park;
+    else
+        parking_lot->parked = stay->next_in_park;
+    if (stay->next_in_park != NULL)
+        stay->next_in_park->prev_in_park = stay->prev_in_park;
+    stay->next_in_park = parking_lot->free_stays;
+    parking_lot->free_stays = stay;
 }
 
 /**
  * Updates the number of available spaces in a parking lot after a vehicle's
- * exit and calulates the parking fee.
- * @param name the parking lot's name
- * @param available_spaces the number of available spaces in the parking lot
+ * exit, calulates the parking fee of the stay and records it in the park's
+ * columns, ledger and occupancy log.
+ * @param parking_lot the parking lot
+ * @param stay the stay that just ended
+ * @param exit the vehicle's exit date and time
+ * @return the row of the stay in the park's columns
  */
-void manage_parking_lot_after_exit(char *name, float *parking_fee,
-char *entry_date, char *entry_time, char *exit_date, char *exit_time) {
-    ParkingLot *parking_lot = find_park_by_name(name);
+int manage_parking_lot_after_exit(ParkingLot *parking_lot, Vehicle *stay,
+Timestamp exit) {
     parking_lot->available_spaces++;
-    *parking_fee = calculate_parking_fee(parking_lot,
-    entry_date, entry_time, exit_date, exit_time);
+    ClosedStay closed = {stay->plate, stay->entry, exit,
+    calculate_parking_fee(parking_lot, stay->entry, exit)};
+    release_stay(parking_lot, stay);
+    log_occupancy_event(&parking_lot->occupancy, exit, 0);
+    return record_exit(parking_lot, &closed);
 }
 
 /**
- * Finds the index of a parking lot by its name.
- * @param name the parking lot's name
- * @return the index of the parking lot in the array of parking lots or
- * -1 if park is not found
+ * Gets the ledger entry of the last day with exits, adding a new one if
+ * the given day comes after it.
+ * @param parking_lot the parking lot
+ * @param day the day of the exit, never before the last day of the ledger
+ * @param row the row of the exit, the first of the day if the day is new
+ * @return the ledger entry for the given day
  */
-int find_parking_lot_index(char *name) {
-    for (int i = 0; i < num_parks; i++)
-        if (strcmp(parking_lots[i].name, name) == 0)
-            return i;
-    return -1;
+static DailyRevenue *ledger_day(ParkingLot *parking_lot, int day, int row) {
+    int last = parking_lot->ledger_size - 1;
+    if (last >= 0 && parking_lot->ledger[last].day == day)
+        return &parking_lot->ledger[last];
+    if (parking_lot->ledger_size == parking_lot->ledger_capacity) {
+        parking_lot->ledger_capacity = parking_lot->ledger_capacity == 0 ?
+        INITIAL_LEDGER_CAPACITY : parking_lot->ledger_capacity * 2;
+        STATS_COUNT(allocations);
+        parking_lot->ledger = realloc(parking_lot->ledger,
+        parking_lot->ledger_capacity * sizeof(DailyRevenue));
+    }
+    DailyRevenue *entry = &parking_lot->ledger[parking_lot->ledger_size++];
+    entry->day = day;
+    entry->total = 0;
+    entry->earlier = last >= 0 ?
+    parking_lot->ledger[last].earlier + parking_lot->ledger[last].total : 0;
+    entry->first_row = row;
+    entry->num_exits = 0;
+    return entry;
+}
+
+/**
+ * Appends a stay that just ended to the columns of its parking lot, adds
+ * it to the revenue and exits of the day it ended and offers it to the
+ * park's ranking of the longest stays. Since exits are registered in
+ * chronological order the stay always belongs either to the last day of the
+ * ledger or to a new day at its end, so the exits of each day are
+ * consecutive rows sorted by exit time.
+ * @param parking_lot the parking lot the vehicle exited
+ * @param stay the stay that just ended
+ * @return the row of the stay in the park's columns
+ */
+int record_exit(ParkingLot *parking_lot, const ClosedStay *stay) {
+    int row = append_closed_stay(&parking_lot->closed, stay);
+    DailyRevenue *entry = ledger_day(parking_lot, timestamp_day(stay->exit),
+    row);
+    entry->num_exits++;
+    entry->total += stay->parking_fee;
+    offer_ranked_stay(&parking_lot->longest_stays, stay->exit - stay->entry,
+    row);
+    return row;
+}
+
+/**
+ * Searches the ledger of a parking lot for a given day using binary search.
+ * @param parking_lot the parking lot
+ * @param day the day being searched
+ * @return the ledger entry of that day or NULL if the park had no exits then
+ */
+DailyRevenue *find_daily_revenue(ParkingLot *parking_lot, int day) {
+    int low = 0, high = parking_lot->ledger_size - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        STATS_COUNT(billing_records_scanned);
+        if (parking_lot->ledger[middle].day == day)
+            return &parking_lot->ledger[middle];
+        if (parking_lot->ledger[middle].day < day)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return NULL;
+}
+
+/**
+ * Frees the ledger of a parking lot. The stays themselves are held by the
+ * park's columns.
+ * @param parking_lot the parking lot
+ */
+void free_ledger(ParkingLot *parking_lot) {
+    free(parking_lot->ledger);
 }
 
 /**
- * Sorts the parking lots by name using Insertion Sort.
- * @param remaining_parks the array of parking lot names
- * @param num_parks the number of parking lots in the array
+ * Shows the revenue made by a parking lot day by day.
+ * @param parking_lot the parking lot
  */
-void sort_parks(char remaining_parks[][BUFSIZ], int num_parks) {
-    // Iterate through the array starting at second element
-    for (int i = 1; i < num_parks; i++) {
-        char key[BUFSIZ];
-        strcpy(key, remaining_parks[i]);
-        int j = i - 1;
-        // Move elements of remaining_parks that are greater than key
-        while (j >= 0 && strcmp(remaining_parks[j], key) > 0) {
-            strcpy(remaining_parks[j + 1], remaining_parks[j]);
-            j = j - 1;
-        }
-        // Place key at after the element that is smaller than it
-        strcpy(remaining_parks[j + 1], key);
+void show_daily_revenue_summary(ParkingLot *parking_lot) {
+    STATS_COUNT(billing_queries);
+    STATS_ADD(billing_records_scanned, parking_lot->ledger_size);
+    for (int i = 0; i < parking_lot->ledger_size; i++) {
+        if (parking_lot->ledger[i].total == 0)
+            continue;
+        write_date(parking_lot->ledger[i].day);
+        write_char(' ');
+        write_money(parking_lot->ledger[i].total);
+        write_char('\n');
     }
 }
 
+/**
+ * Calculates the revenue a parking lot made up to a given day, from the
+ * running totals of its ledger, using binary search.
+ * @param parking_lot the parking lot
+ * @param day the last day counted
+ * @return the revenue of that day and every day before it
+ */
+Cents revenue_until(ParkingLot *parking_lot, int day) {
+    // Ends as the number of ledger entries of days up to the given one
+    int low = 0, high = parking_lot->ledger_size;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        STATS_COUNT(billing_records_scanned);
+        if (parking_lot->ledger[middle].day <= day)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return 0;
+    return parking_lot->ledger[low - 1].earlier +
+    parking_lot->ledger[low - 1].total;
+}
+
+/**
+ * Calculates the revenue a parking lot made in a range of days.
+ * @param parking_lot the parking lot
+ * @param first_day the first day of the range
+ * @param last_day the last day of the range, not before the first one
+ * @return the revenue of the days in the range
+ */
+Cents revenue_between(ParkingLot *parking_lot, int first_day, int last_day) {
+    return revenue_until(parking_lot, last_day) -
+    revenue_until(parking_lot, first_day - 1);
+}
+
+/**
+ * Shows the revenue made in a range of days by a parking lot or by all
+ * parking lots.
+ * @param parking_lot the parking lot or NULL for all of them
+ * @param first_day the first day of the range
+ * @param last_day the last day of the range, not before the first one
+ */
+void show_revenue_between(ParkingLot *parking_lot, int first_day,
+int last_day) {
+    Cents revenue = 0;
+    STATS_COUNT(billing_queries);
+    if (parking_lot != NULL)
+        revenue = revenue_between(parking_lot, first_day, last_day);
+    else
+        for (int position = 0; position < num_parks; position++)
+            revenue += revenue_between(find_park_by_position(position),
+            first_day, last_day);
+    write_money(revenue);
+    write_char('\n');
+}
+
+/**
+ * Extracts the arguments of command i and shows the revenue made in a range
+ * of days, or prints a descriptive error message if the parking lot doesn't
+ * exist or the range is invalid.
+ * @param command command in format "i <name> <date> <date>" or
+ * "i <date> <date>"
+ * @param latest the latest date and time registered in the system
+ */
+void list_revenue(Command *command, Timestamp latest) {
+    if (command->num_arguments < 2)
+        return;
+    // The dates follow the name, if there is one
+    int named = command->num_arguments >= 3;
+    char *name = command->arguments[0];
+    ParkingLot *parking_lot = named ? find_park_by_name(name) : NULL;
+    int first_day = parse_date(command->arguments[named]);
+    int last_day = parse_date(command->arguments[named + 1]);
+    if (named && parking_lot == NULL)
+        write_message(name, "no such parking.");
+    else if (first_day == -1 || last_day == -1 || first_day > last_day ||
+    last_day > timestamp_day(latest))
+        write_error("invalid date.");
+    else
+        show_revenue_between(parking_lot, first_day, last_day);
+}
+
+/**
+ * Extracts the arguments of command o and shows how many vehicles were
+ * parked in a parking lot at a given date and time, or prints a descriptive
+ * error message if the parking lot doesn't exist or the date is invalid.
+ * @param command command in format "o <name> <date> <time>"
+ * @param latest the latest date and time registered in the system
+ */
+void show_occupancy(Command *command, Timestamp latest) {
+    if (command->num_arguments < 3)
+        return;
+    char *name = command->arguments[0];
+    ParkingLot *parking_lot = find_park_by_name(name);
+    Timestamp time = parse_datetime(command->arguments[1],
+    command->arguments[2]);
+    if (parking_lot == NULL) {
+        write_message(name, "no such parking.");
+    } else if (time == NO_TIMESTAMP || time > latest) {
+        write_error("invalid date.");
+    } else {
+        write_integer(occupancy_at(&parking_lot->occupancy, time));
+        write_char('\n');
+    }
+}
+
+/**
+ * Displays the totals of a ranking of a parking lot from best to worst in
+ * format: <plate> <total>.
+ * @param top the ranking
+ */
+void display_ranked_totals(const TopStays *top) {
+    RankedStay ranked[TOP_RANKED];
+    int num_ranked = sorted_top_stays(top, ranked);
+    for (int i = 0; i < num_ranked; i++) {
+        write_bytes((const char *)&ranked[i].plate, PLATE_CHARACTERS);
+        write_char(' ');
+        write_money(ranked[i].value);
+        write_char('\n');
+    }
+}
+
+/**
+ * Displays the stays of a ranking of a parking lot from best to worst in
+ * format: <plate> <entry_date> <entry_time> <exit_date> <exit_time> <fee>.
+ * @param parking_lot the parking lot
+ * @param top the ranking
+ */
+void display_ranked_stays(ParkingLot *parking_lot, const TopStays *top) {
+    RankedStay ranked[TOP_RANKED];
+    int num_ranked = sorted_top_stays(top, ranked);
+    for (int i = 0; i < num_ranked; i++) {
+        ClosedStay stay;
+        get_closed_stay(&parking_lot->closed, ranked[i].row, &stay);
+        write_bytes((const char *)&stay.plate, PLATE_CHARACTERS);
+        write_char(' ');
+        write_datetime(stay.entry);
+        write_char(' ');
+        write_datetime(stay.exit);
+        write_char(' ');
+        write_money(stay.parking_fee);
+        write_char('\n');
+    }
+}
+
+/**
+ * Shows the vehicles that paid the most in a parking lot in total, for
+ * command t, or the stays that ended there with the longest durations, for
+ * command l. Prints a descriptive error message if the parking lot doesn't
+ * exist.
+ * @param command command in format "t <name>" or "l <name>"
+ */
+void list_top_stays(Command *command) {
+    if (command->num_arguments < 1)
+        return;
+    char *name = command->arguments[0];
+    ParkingLot *parking_lot = find_park_by_name(name);
+    if (parking_lot == NULL)
+        write_message(name, "no such parking.");
+    else if (command->type == 't')
+        display_ranked_totals(&parking_lot->highest_totals);
+    else
+        display_ranked_stays(parking_lot, &parking_lot->longest_stays);
+}
+
+/**
+ * Compares two parking lot names, to be used with qsort.
+ * @param name1 pointer to the first name
+ * @param name2 pointer to the second name
+ * @return a negative integer, 0 or a positive integer if the first name is
+ * respectively smaller than, equal to or greater than the second
+ */
+int compare_park_names(const void *name1, const void *name2) {
+    return strcmp(*(char **)name1, *(char **)name2);
+}
+
 /**
  * Prints the remaining parking lots after a removal in a sorted order.
  */
 void print_remaining_parks() {
-    char remaining_parks[MAX_PARKS][BUFSIZ];
+    char **remaining_parks = (char **)malloc(num_parks * sizeof(char *));
+    for (int position = 0; position < num_parks; position++)
+        remaining_parks[position] = find_park_by_position(position)->name;
+    qsort(remaining_parks, num_parks, sizeof(char *), compare_park_names);
     for (int i = 0; i < num_parks; i++)
-        strcpy(remaining_parks[i], parking_lots[i].name);
-    sort_parks(remaining_parks, num_parks);
-    for (int i = 0; i < num_parks; i++)
-        printf("%s\n", remaining_parks[i]);
+        write_line(remaining_parks[i]);
+    free(remaining_parks);
 }
 
 /**
- * Removes a parking lot entry from the array of parking lots.
- * @param index the index of the parking lot to be removed
+ * Takes a removed park's id out of the ids of the existing parks, keeping
+ * the others in order of creation.
+ * @param id the id of the removed park
  */
-void remove_parking_lot_entry(int index) {
-    remove_entries_for_parking_lot(parking_lots[index].name);
-    free(parking_lots[index].name);
-    for (int i = index; i < num_parks - 1; i++)
-        parking_lots[i] = parking_lots[i+1];
+static void remove_live_park_id(int id) {
+    int position = 0;
+    while (live_park_ids[position] != id)
+        position++;
     num_parks--;
+    memmove(&live_park_ids[position], &live_park_ids[position + 1],
+    (num_parks - position) * sizeof(int));
+}
+
+/**
+ * Removes a parking lot and all of its entries from the system. Its id is
+ * not given to any other park.
+ * @param id the id of the parking lot to be removed
+ */
+void remove_parking_lot_entry(int id) {
+    ParkingLot *parking_lot = parking_lots[id];
+    remove_entries_for_parking_lot(parking_lot);
+    *find_directory_slot(parking_lot->name) = PARK_SLOT_DELETED;
+    shift_park_ranks(id, -1);
+    free(parking_lot->name);
+    free_park_stays(parking_lot);
+    free(parking_lot);
+    parking_lots[id] = NULL;
+    remove_live_park_id(id);
+}
+
+/**
+ * Adds up the memory taken by the stays of every parking lot, both those of
+ * parked vehicles and those in the columns.
+ * @param bytes_used where the bytes in use by stays are stored
+ * @param bytes_reserved where the bytes reserved for stays are stored
+ */
+void stays_memory_usage(size_t *bytes_used, size_t *bytes_reserved) {
+    *bytes_used = 0;
+    *bytes_reserved = 0;
+    for (int position = 0; position < num_parks; position++) {
+        ParkingLot *parking_lot = find_park_by_position(position);
+        StayColumns *closed = &parking_lot->closed;
+        OccupancyLog *occupancy = &parking_lot->occupancy;
+        *bytes_used += arena_bytes_used(&parking_lot->stays) +
+        closed->num_rows * sizeof(ClosedStay) +
+        occupancy->num_events * sizeof(Timestamp);
+        *bytes_reserved += arena_bytes_reserved(&parking_lot->stays) +
+        stay_columns_bytes(closed) + occupancy_log_bytes(occupancy);
+    }
 }
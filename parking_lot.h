@@ -14,36 +14,109 @@
 #include <string.h>
 #include "utils.h"
 #include "vehicle.h"
+#include "hash_table.h"
+#include "datetime.h"
+#include "command.h"
+#include "output.h"
+#include "arena.h"
+#include "money.h"
+#include "stats.h"
+#include "journal.h"
+#include "stay_columns.h"
+#include "occupancy.h"
+#include "top_stays.h"
 
+// Most parks that may exist at once, can be raised with -DMAX_PARKS=<n>
+#ifndef MAX_PARKS
 #define MAX_PARKS 20
+#endif
+#define INITIAL_PARKS_CAPACITY 16
+#define INITIAL_DIRECTORY_CAPACITY 32
+#define PARK_SLOT_EMPTY -1
+#define PARK_SLOT_DELETED -2
+#define INITIAL_LEDGER_CAPACITY 8
+#define MINUTES_PER_QUARTER_HOUR 15
+#define QUARTER_HOURS_IN_FIRST_HOUR 4
+// Started quarter hours in what is left of a stay after its full days
+#define TARIFF_SLOTS (MINUTES_PER_DAY / MINUTES_PER_QUARTER_HOUR + 1)
+
+/*daily revenue structure, one per day in which a park registered exits*/
+typedef struct DailyRevenue {
+    int day; // days elapsed since 01-01-0000
+    Cents total;
+    Cents earlier; // revenue of every day of the ledger before this one
+    int first_row; // row of the park's columns of the first exit this day
+    int num_exits; // the day's exits are the rows that follow, in order
+} DailyRevenue;
 
 /*parking lot structure*/
 typedef struct ParkingLot {
+    int id; // position in the array of parking lots, never reused
     char *name;
     int capacity;
-    float quarter_hourly_rate;
-    float quarter_hourly_rate_after_first_hour;
-    float max_daily_cost;
+    Cents quarter_hourly_rate;
+    Cents quarter_hourly_rate_after_first_hour;
+    Cents max_daily_cost;
+    Cents tariff[TARIFF_SLOTS]; // capped cost of each number of quarter hours
     int available_spaces;
+    DailyRevenue *ledger; // sorted by day, as exits are chronological
+    int ledger_size;
+    int ledger_capacity;
+    StayColumns closed; // stays that ended in the park, in order of exit
+    OccupancyLog occupancy; // entries and exits of the park, in order of time
+    TopStays highest_totals; // vehicles that paid the most there in total
+    TopStays longest_stays; // stays that ended with the longest durations
+    Arena stays; // holds the stays of the vehicles parked in the park
+    struct Vehicle *parked; // stays of the vehicles parked in the park
+    struct Vehicle *free_stays; // stays that ended, reused by later entries
 } ParkingLot;
 
+/*park directory structure, an open addressing hash table from names to ids*/
+typedef struct ParkDirectory {
+    int *slots; // park id, PARK_SLOT_EMPTY or PARK_SLOT_DELETED
+    int capacity;
+    int used; // live and deleted slots
+} ParkDirectory;
+
 
 /*Function Prototypes*/
-void cleanup(char *command);
+void cleanup();
+int find_park_id(char *name);
+ParkingLot *find_park_by_id(int id);
+int count_parks();
+ParkingLot *find_park_by_position(int position);
+int park_name_rank(int id);
+int count_park_ids();
 ParkingLot *find_park_by_name(char *name);
 void list_parking_lots();
-int park_is_full(char *name);
-float calculate_parking_fee(ParkingLot *parking_lot, char *entry_date,
-char *entry_time, char *exit_date, char *exit_time);
+int park_is_full(ParkingLot *parking_lot);
+void build_tariff(ParkingLot *parking_lot);
+Cents calculate_parking_fee(ParkingLot *parking_lot, Timestamp entry,
+Timestamp exit);
 int is_valid_parking_lot(char *name, int capacity,
-float quarter_hourly_rate, float quarter_hourly_rate_after_first_hour, 
-float max_daily_cost);
-void create_parking_lot(char *command);
-void update_available_spaces_after_entry(char *name, int *avalable_spaces);
-void manage_parking_lot_after_exit(char *name, float *parking_fee,
-char *entry_date, char *entry_time, char *exit_date, char *exit_time);
-int find_parking_lot_index(char *name);
-void sort_parks(char remaining_parks[][BUFSIZ], int num_parks);
+Cents quarter_hourly_rate, Cents quarter_hourly_rate_after_first_hour, 
+Cents max_daily_cost);
+ParkingLot *add_parking_lot(char *name, int capacity, Cents rates[3]);
+void create_parking_lot(Command *command);
+int update_available_spaces_after_entry(ParkingLot *parking_lot);
+struct Vehicle *allocate_stay(ParkingLot *parking_lot);
+int manage_parking_lot_after_exit(ParkingLot *parking_lot,
+struct Vehicle *stay, Timestamp exit);
+int record_exit(ParkingLot *parking_lot, const ClosedStay *stay);
+DailyRevenue *find_daily_revenue(ParkingLot *parking_lot, int day);
+void free_ledger(ParkingLot *parking_lot);
+void show_daily_revenue_summary(ParkingLot *parking_lot);
+Cents revenue_until(ParkingLot *parking_lot, int day);
+Cents revenue_between(ParkingLot *parking_lot, int first_day, int last_day);
+void show_revenue_between(ParkingLot *parking_lot, int first_day,
+int last_day);
+void list_revenue(Command *command, Timestamp latest);
+void show_occupancy(Command *command, Timestamp latest);
+void display_ranked_totals(const TopStays *top);
+void display_ranked_stays(ParkingLot *parking_lot, const TopStays *top);
+void list_top_stays(Command *command);
+int compare_park_names(const void *name1, const void *name2);
 void print_remaining_parks();
-void remove_parking_lot_entry(int index);
+void remove_parking_lot_entry(int id);
+void stays_memory_usage(size_t *bytes_used, size_t *bytes_reserved);
 #endif
@@ -0,0 +1,190 @@
+/**
+ * File containing the threaded command pipeline of the park management
+ * system. A reader thread reads the lines and splits them into commands,
+ * the calling thread executes them in order and a writer thread writes out
+ * the output, the stages being connected by lock free rings. Commands are
+ * handed over in batches so that the threads rarely have to wait for each
+ * other. Executing the commands in a single thread keeps their order and
+ * output exactly the same as when run without the pipeline.
+ * @file pipeline.c
+ * @author @inesiscosta
+ */
+
+#include "pipeline.h"
+
+/**
+ * Copies a line into a batch and splits it into a command.
+ * @param batch the batch
+ * @param line the line
+ * @return 1 if the line was added, 0 if the batch has no room for it
+ */
+static int add_line(CommandBatch *batch, const char *line) {
+    size_t size = strlen(line) + 1;
+    if (batch->num_commands == BATCH_COMMANDS ||
+    size > batch->text_capacity - batch->text_length) {
+        // Pointers into the text only exist once a command was added
+        if (batch->num_commands > 0)
+            return 0;
+        batch->text_capacity = size;
+        batch->text = (char *)realloc(batch->text, batch->text_capacity);
+    }
+    char *copy = memcpy(batch->text + batch->text_length, line, size);
+    batch->text_length += size;
+    tokenize_command(copy, &batch->commands[batch->num_commands++]);
+    return 1;
+}
+
+/**
+ * Fills a batch with the next commands of the input. The batch is handed
+ * over early if reading would have to wait, so that commands typed or piped
+ * in slowly aren't held back.
+ * @param batch the batch
+ * @param input the input with the commands
+ * @param pending the line that didn't fit in the previous batch or NULL,
+ * updated with the line that doesn't fit in this one
+ */
+static void fill_batch(CommandBatch *batch, InputReader *input,
+char **pending) {
+    batch->num_commands = 0;
+    batch->text_length = 0;
+    batch->last = 0;
+    do {
+        if (*pending == NULL && batch->num_commands > 0 &&
+        !has_buffered_input(input))
+            return;
+        if (*pending == NULL && (*pending = read_line(input)) == NULL) {
+            batch->last = 1;
+            return;
+        }
+        if (!add_line(batch, *pending))
+            return;
+        *pending = NULL;
+    } while (1);
+}
+
+/**
+ * Body of the reader thread, which fills batches until the input ends or
+ * the pipeline stops.
+ * @param argument the pipeline
+ * @return NULL
+ */
+static void *read_commands(void *argument) {
+    Pipeline *pipeline = argument;
+    CommandBatch *batch;
+    char *pending = NULL;
+    while ((batch = ring_pop(&pipeline->empty)) != NULL) {
+        fill_batch(batch, pipeline->input, &pending);
+        if (!ring_push(&pipeline->filled, batch) || batch->last)
+            break;
+    }
+    return NULL;
+}
+
+/**
+ * Executes the commands of a batch in order. Long enough runs of queries are
+ * run by the query pool, if there is one.
+ * @param pipeline the pipeline
+ * @param batch the batch
+ * @param latest the latest date and time registered in the system
+ * @return 0 if one of the commands was q, 1 otherwise
+ */
+static int execute_batch(Pipeline *pipeline, CommandBatch *batch,
+Timestamp *latest) {
+    Command *commands = batch->commands;
+    int i = 0;
+    while (i < batch->num_commands) {
+        int queries = 0;
+        while (pipeline->queries != NULL &&
+        i + queries < batch->num_commands && is_query(&commands[i + queries]))
+            queries++;
+        if (queries >= MIN_PARALLEL_QUERIES) {
+            run_queries(pipeline->queries, &commands[i], queries, *latest);
+            i += queries;
+        } else if (!execute_command(&commands[i++], latest)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Executes the batches filled by the reader thread until the input ends or
+ * command q.
+ * @param pipeline the pipeline
+ * @param latest the latest date and time registered in the system
+ * @return 1 if the input ended, 0 if it was command q
+ */
+static int execute_batches(Pipeline *pipeline, Timestamp *latest) {
+    CommandBatch *batch;
+    while ((batch = ring_pop(&pipeline->filled)) != NULL) {
+        if (!execute_batch(pipeline, batch, latest))
+            return 0;
+        if (batch->last)
+            return 1;
+        ring_push(&pipeline->empty, batch);
+    }
+    return 1;
+}
+
+/**
+ * Sets up the rings and the empty batches of a pipeline.
+ * @param pipeline the pipeline
+ * @param input the input with the commands
+ */
+static void init_pipeline(Pipeline *pipeline, InputReader *input) {
+    pipeline->input = input;
+    ring_init(&pipeline->filled, PIPELINE_BATCHES);
+    ring_init(&pipeline->empty, PIPELINE_BATCHES);
+    for (int i = 0; i < PIPELINE_BATCHES; i++) {
+        pipeline->batches[i].text_capacity = BATCH_TEXT_SIZE;
+        pipeline->batches[i].text = (char *)malloc(BATCH_TEXT_SIZE);
+        ring_push(&pipeline->empty, &pipeline->batches[i]);
+    }
+}
+
+/**
+ * Frees the rings and the batches of a pipeline.
+ * @param pipeline the pipeline
+ */
+static void free_pipeline(Pipeline *pipeline) {
+    for (int i = 0; i < PIPELINE_BATCHES; i++)
+        free(pipeline->batches[i].text);
+    ring_free(&pipeline->filled);
+    ring_free(&pipeline->empty);
+    free(pipeline);
+}
+
+/**
+ * Reads and processes the commands until the input ends or command q,
+ * reading and writing in threads of their own. After command q the reader
+ * thread is cancelled, as it may be waiting for input that never comes.
+ * @param input the input with the commands
+ * @param latest the latest date and time registered in the system
+ * @param query_workers the number of threads that run queries in parallel,
+ * 0 to run them in order with the other commands
+ * @return 1 if the commands were processed, 0 if the threads couldn't be
+ * started and nothing was read
+ */
+int run_pipeline(InputReader *input, Timestamp *latest, int query_workers) {
+    Pipeline *pipeline = (Pipeline *)malloc(sizeof(Pipeline));
+    init_pipeline(pipeline, input);
+    if (pthread_create(&pipeline->reader, NULL, read_commands,
+    pipeline) != 0) {
+        free_pipeline(pipeline);
+        return 0;
+    }
+    start_output_writer();
+    pipeline->queries = query_workers > 0 ?
+    start_query_pool(query_workers) : NULL;
+    int ended = execute_batches(pipeline, latest);
+    ring_close(&pipeline->empty);
+    ring_close(&pipeline->filled);
+    if (!ended)
+        pthread_cancel(pipeline->reader);
+    pthread_join(pipeline->reader, NULL);
+    if (pipeline->queries != NULL)
+        stop_query_pool(pipeline->queries);
+    stop_output_writer();
+    free_pipeline(pipeline);
+    return 1;
+}
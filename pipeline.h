@@ -0,0 +1,48 @@
+/**
+ * Header file for pipeline.c
+ * @file pipeline.h
+ * @author @inesiscosta
+*/
+
+#ifndef PIPELINE
+#define PIPELINE
+
+/*Includes*/
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "command.h"
+#include "input.h"
+#include "output.h"
+#include "ring.h"
+#include "queries.h"
+
+/*Constants*/
+#define BATCH_COMMANDS 1024
+#define BATCH_TEXT_SIZE (1 << 16)
+// Batches filled or being executed at once, a power of 2
+#define PIPELINE_BATCHES 8
+
+/*Command Batch Structure, consecutive commands handed over at once*/
+typedef struct CommandBatch {
+    Command commands[BATCH_COMMANDS]; // arguments point into text
+    int num_commands;
+    int last; // set on the batch that ends the input
+    char *text; // copies of the lines of the commands
+    size_t text_length;
+    size_t text_capacity;
+} CommandBatch;
+
+/*Pipeline Structure*/
+typedef struct Pipeline {
+    InputReader *input;
+    CommandBatch batches[PIPELINE_BATCHES];
+    Ring filled; // batches waiting to be executed, in order
+    Ring empty; // batches the reader thread may fill
+    pthread_t reader;
+    QueryPool *queries; // runs queries in parallel or NULL
+} Pipeline;
+
+/*Function Prototypes*/
+int run_pipeline(InputReader *input, Timestamp *latest, int query_workers);
+#endif
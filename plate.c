@@ -0,0 +1,71 @@
+/**
+ * File containing the license plates of the park management system. A plate
+ * is always 8 characters long, so it is packed into a single 64 bit key
+ * once it is read. Keys are validated a word at a time, compared as numbers
+ * and hashed with a couple of multiplications.
+ * @file plate.c
+ * @author @inesiscosta
+ */
+
+#include "plate.h"
+
+/**
+ * Marks the bytes of a word that are strictly between two values, for words
+ * whose bytes are below 128 or are left unmarked.
+ * @param word the word
+ * @param low the value below the range
+ * @param high the value above the range
+ * @return the word with the top bit of every byte in the range set
+ */
+static uint64_t bytes_between(uint64_t word, unsigned low, unsigned high) {
+    uint64_t low_bits = word & BYTES(0x7f);
+    return (BYTES(127 + high) - low_bits) & ~word &
+    (low_bits + BYTES(127 - low)) & BYTES(0x80);
+}
+
+/**
+ * Checks whether a key is a valid plate: uppercase letters, digits and
+ * dashes with dashes between its three pairs of characters, where a letter
+ * and a digit are never next to each other and there are at least two
+ * letters and two digits. Every character is checked at once.
+ * @param key the key
+ * @return 1 if the key is a valid plate, 0 otherwise
+ */
+int is_valid_plate_key(PlateKey key) {
+    uint64_t digits = bytes_between(key, '0' - 1, '9' + 1);
+    uint64_t letters = bytes_between(key, 'A' - 1, 'Z' + 1);
+    uint64_t dashes = bytes_between(key, '-' - 1, '-' + 1);
+    // Neighbours other than those in a pair are split by a dash
+    uint64_t mixed = (digits & letters >> 8) | (letters & digits >> 8);
+    return (digits | letters | dashes) == BYTES(0x80) &&
+    (dashes & PLATE_DASHES) == PLATE_DASHES && (mixed & PLATE_PAIRS) == 0 &&
+    (digits & (digits - 1)) != 0 && (letters & (letters - 1)) != 0;
+}
+
+/**
+ * Checks if a license plate is valid and packs it into a key.
+ * @param plate the license plate to be checked
+ * @param key where the key is stored
+ * @return 1 if the license plate is valid, 0 otherwise
+ */
+int parse_plate(const char *plate, PlateKey *key) {
+    if (strnlen(plate, LICENSE_PLATE_LENGTH) != PLATE_CHARACTERS)
+        return 0;
+    memcpy(key, plate, PLATE_CHARACTERS);
+    return is_valid_plate_key(*key);
+}
+
+/**
+ * Computes the hash of a key with the finalizer of MurmurHash3, so that the
+ * low bits used to index a table depend on every character.
+ * @param key the key
+ * @return the hash of the key
+ */
+unsigned int hash_plate(PlateKey key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return (unsigned int)key;
+}
@@ -0,0 +1,34 @@
+/**
+ * Header file for plate.c
+ * @file plate.h
+ * @author @inesiscosta
+*/
+
+#ifndef PLATE
+#define PLATE
+
+/*Includes*/
+#include <stdint.h>
+#include <string.h>
+
+/*Constants*/
+#define PLATE_CHARACTERS 8
+// Characters of a plate plus its terminator
+#define LICENSE_PLATE_LENGTH (PLATE_CHARACTERS + 1)
+// Key no valid plate packs to, marks empty slots and missing plates
+#define NO_PLATE 0
+// One byte of a word repeated over all of its 8 bytes
+#define BYTES(byte) (0x0101010101010101ull * (byte))
+// Top bits of the bytes holding the dashes between the pairs of a plate and
+// of the first byte of each pair, the same in either byte order
+#define PLATE_DASHES (0x80ull << 16 | 0x80ull << 40)
+#define PLATE_PAIRS (0x80ull | 0x80ull << 24 | 0x80ull << 48)
+
+/*The 8 characters of a plate in the order they're in memory*/
+typedef uint64_t PlateKey;
+
+/*Function Prototypes*/
+int is_valid_plate_key(PlateKey key);
+int parse_plate(const char *plate, PlateKey *key);
+unsigned int hash_plate(PlateKey key);
+#endif
@@ -0,0 +1,133 @@
+/**
+ * File containing the pool of worker threads that run queries in parallel.
+ * Queries (commands v, w, f, i, o, t, l and p without arguments) only read
+ * the state, so a run of consecutive queries can be spread over the workers
+ * while the thread executing the commands waits, which keeps the state they
+ * see the same for all of them. Each query's output is captured and written
+ * out in the order the queries came in.
+ * @file queries.c
+ * @author @inesiscosta
+ */
+
+#include "queries.h"
+
+/**
+ * Runs the queries of the current run that no other worker took yet,
+ * capturing the output of each one.
+ * @param pool the query pool
+ */
+static void take_queries(QueryPool *pool) {
+    Timestamp latest = pool->latest;
+    int i;
+    while ((i = atomic_fetch_add_explicit(&pool->next_command, 1,
+    memory_order_relaxed)) < pool->num_commands) {
+        start_capture(&pool->results[i]);
+        execute_command(&pool->commands[i], &latest);
+        stop_capture();
+    }
+}
+
+/**
+ * Body of a worker thread, which takes part in every run of queries until
+ * the pool stops.
+ * @param argument the query pool
+ * @return NULL
+ */
+static void *query_worker(void *argument) {
+    QueryPool *pool = argument;
+    int generation = 0;
+    initialize_thread_output();
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (!pool->stopping && pool->generation == generation)
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        if (pool->stopping)
+            break;
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        take_queries(pool);
+        pthread_mutex_lock(&pool->lock);
+        if (++pool->idle_workers == pool->num_workers)
+            pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    free_thread_output();
+    return NULL;
+}
+
+/**
+ * Starts a pool of worker threads.
+ * @param num_workers the number of workers, at most MAX_QUERY_WORKERS
+ * @return the pool or NULL if no worker could be started
+ */
+QueryPool *start_query_pool(int num_workers) {
+#ifdef STATS
+    // The counters aren't safe to share, so queries run in the main thread
+    num_workers = 0;
+#endif
+    QueryPool *pool = (QueryPool *)calloc(1, sizeof(QueryPool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    for (int i = 0; i < num_workers && i < MAX_QUERY_WORKERS; i++)
+        if (pthread_create(&pool->workers[pool->num_workers], NULL,
+        query_worker, pool) == 0)
+            pool->num_workers++;
+    if (pool->num_workers == 0) {
+        stop_query_pool(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Runs a run of queries on the workers and writes out their output in
+ * order once all of them are done.
+ * @param pool the query pool
+ * @param commands the queries
+ * @param num_commands the number of queries
+ * @param latest the latest date and time registered in the system
+ */
+void run_queries(QueryPool *pool, Command *commands, int num_commands,
+Timestamp latest) {
+    if (num_commands > pool->results_capacity) {
+        pool->results = (OutputCapture *)realloc(pool->results,
+        num_commands * sizeof(OutputCapture));
+        for (int i = pool->results_capacity; i < num_commands; i++)
+            pool->results[i] = (OutputCapture){NULL, 0, 0};
+        pool->results_capacity = num_commands;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->commands = commands;
+    pool->num_commands = num_commands;
+    pool->latest = latest;
+    atomic_store_explicit(&pool->next_command, 0, memory_order_relaxed);
+    pool->idle_workers = 0;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    while (pool->idle_workers < pool->num_workers)
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < num_commands; i++)
+        write_bytes(pool->results[i].data, pool->results[i].length);
+}
+
+/**
+ * Stops the workers of a pool and frees it.
+ * @param pool the query pool
+ */
+void stop_query_pool(QueryPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->num_workers; i++)
+        pthread_join(pool->workers[i], NULL);
+    for (int i = 0; i < pool->results_capacity; i++)
+        free(pool->results[i].data);
+    free(pool->results);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    free(pool);
+}
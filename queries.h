@@ -0,0 +1,45 @@
+/**
+ * Header file for queries.c
+ * @file queries.h
+ * @author @inesiscosta
+*/
+
+#ifndef QUERIES
+#define QUERIES
+
+/*Includes*/
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "command.h"
+#include "output.h"
+
+/*Constants*/
+// Shorter runs of queries aren't worth waking the workers for
+#define MIN_PARALLEL_QUERIES 16
+#define MAX_QUERY_WORKERS 64
+
+/*Query Pool Structure, worker threads that run queries side by side*/
+typedef struct QueryPool {
+    pthread_t workers[MAX_QUERY_WORKERS];
+    int num_workers;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    int generation; // number of runs handed out so far
+    int idle_workers; // workers done with the current run
+    int stopping;
+    Command *commands; // the run of queries being executed
+    int num_commands;
+    Timestamp latest;
+    atomic_int next_command; // next query of the run to be taken
+    OutputCapture *results; // output of each query of the run
+    int results_capacity;
+} QueryPool;
+
+/*Function Prototypes*/
+QueryPool *start_query_pool(int num_workers);
+void run_queries(QueryPool *pool, Command *commands, int num_commands,
+Timestamp latest);
+void stop_query_pool(QueryPool *pool);
+#endif
@@ -0,0 +1,98 @@
+/**
+ * File containing the single producer, single consumer rings that connect
+ * the threads of the command pipeline. The producer only ever moves the tail
+ * and the consumer only ever moves the head, so each side publishes its
+ * progress with a release store the other side reads with an acquire load.
+ * @file ring.c
+ * @author @inesiscosta
+ */
+
+#include "ring.h"
+
+/**
+ * Initializes an empty ring.
+ * @param ring the ring to be initialized
+ * @param capacity the number of items it holds, must be a power of two
+ */
+void ring_init(Ring *ring, size_t capacity) {
+    ring->slots = (void **)malloc(capacity * sizeof(void *));
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->closed, 0);
+}
+
+/**
+ * Frees the slots of a ring. The items are owned by the caller.
+ * @param ring the ring
+ */
+void ring_free(Ring *ring) {
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+/**
+ * Waits a little before checking a ring again, longer the more times the
+ * thread has already waited.
+ * @param waits the number of times the thread waited, updated
+ */
+static void ring_wait(int *waits) {
+    static const struct timespec pause = {0, RING_SLEEP_NANOSECONDS};
+    if (*waits >= RING_SPINS + RING_YIELDS) {
+        nanosleep(&pause, NULL);
+        return;
+    }
+    if (*waits >= RING_SPINS)
+        sched_yield();
+    (*waits)++;
+}
+
+/**
+ * Adds an item to a ring, waiting for a free slot if it is full. Only the
+ * producer thread may call it.
+ * @param ring the ring
+ * @param item the item
+ * @return 1 if the item was added, 0 if the ring was closed
+ */
+int ring_push(Ring *ring, void *item) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    int waits = 0;
+    while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) >
+    ring->mask) {
+        if (atomic_load_explicit(&ring->closed, memory_order_acquire))
+            return 0;
+        ring_wait(&waits);
+    }
+    ring->slots[tail & ring->mask] = item;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+/**
+ * Takes the oldest item of a ring, waiting for one if it is empty. Only the
+ * consumer thread may call it.
+ * @param ring the ring
+ * @return the item or NULL once the ring is closed and empty
+ */
+void *ring_pop(Ring *ring) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    int waits = 0;
+    while (head == atomic_load_explicit(&ring->tail, memory_order_acquire)) {
+        // Items added before the ring was closed are still handed out
+        if (atomic_load_explicit(&ring->closed, memory_order_acquire) &&
+        head == atomic_load_explicit(&ring->tail, memory_order_acquire))
+            return NULL;
+        ring_wait(&waits);
+    }
+    void *item = ring->slots[head & ring->mask];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return item;
+}
+
+/**
+ * Closes a ring, so that both threads stop waiting on it.
+ * @param ring the ring
+ */
+void ring_close(Ring *ring) {
+    atomic_store_explicit(&ring->closed, 1, memory_order_release);
+}
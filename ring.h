@@ -0,0 +1,39 @@
+/**
+ * Header file for ring.c
+ * @file ring.h
+ * @author @inesiscosta
+*/
+
+#ifndef RING
+#define RING
+
+/*Includes*/
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <time.h>
+
+/*Constants*/
+#define RING_CACHE_LINE 64
+// Waits first spin, then give the core away and finally sleep
+#define RING_SPINS 64
+#define RING_YIELDS 256
+#define RING_SLEEP_NANOSECONDS 50000
+
+/*Ring Structure, a bounded queue between one producer and one consumer
+thread that never takes a lock*/
+typedef struct Ring {
+    void **slots;
+    size_t mask; // number of slots minus one, the number being a power of 2
+    _Alignas(RING_CACHE_LINE) atomic_size_t head; // next slot to be taken
+    _Alignas(RING_CACHE_LINE) atomic_size_t tail; // next slot to be filled
+    _Alignas(RING_CACHE_LINE) atomic_int closed;
+} Ring;
+
+/*Function Prototypes*/
+void ring_init(Ring *ring, size_t capacity);
+void ring_free(Ring *ring);
+int ring_push(Ring *ring, void *item);
+void *ring_pop(Ring *ring);
+void ring_close(Ring *ring);
+#endif
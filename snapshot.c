@@ -0,0 +1,295 @@
+/**
+ * File containing the binary snapshots of the park management system.
+ * A snapshot holds the whole state of the system, so that a restart doesn't
+ * need to replay the commands that built it. Loading maps the file into
+ * memory and restores the parks, along with the columns of their stays,
+ * straight from their records without parsing any text. The vehicle
+ * histories and the ledgers are rebuilt from the columns.
+ * @file snapshot.c
+ * @author @inesiscosta
+ */
+
+#include "snapshot.h"
+
+// Offset of each column in a block, in the order they're written
+static const size_t column_offsets[SNAPSHOT_COLUMNS] = {
+    offsetof(StayBlock, plates), offsetof(StayBlock, entries),
+    offsetof(StayBlock, exits), offsetof(StayBlock, fees)
+};
+
+/**
+ * Rounds a size up to the alignment of the snapshot's records.
+ * @param size the size
+ * @return the aligned size
+ */
+static size_t snapshot_align(size_t size) {
+    return (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT *
+    SNAPSHOT_ALIGNMENT;
+}
+
+/**
+ * Writes bytes to a snapshot followed by zeros up to the next alignment.
+ * @param file the snapshot file
+ * @param data the bytes
+ * @param size the number of bytes
+ */
+static void write_aligned(FILE *file, const void *data, size_t size) {
+    static const char padding[SNAPSHOT_ALIGNMENT] = {0};
+    fwrite(data, 1, size, file);
+    fwrite(padding, 1, snapshot_align(size) - size, file);
+}
+
+/**
+ * Writes a column of a parking lot's stays that ended, a block at a time.
+ * @param file the snapshot file
+ * @param columns the columns of the parking lot
+ * @param offset the offset of the column in each block
+ */
+static void write_column(FILE *file, const StayColumns *columns,
+size_t offset) {
+    for (int i = 0; i < columns->num_blocks; i++) {
+        int rows = columns->num_rows - i * STAY_BLOCK_ROWS;
+        fwrite((const char *)columns->blocks[i] + offset, sizeof(int64_t),
+        rows < STAY_BLOCK_ROWS ? rows : STAY_BLOCK_ROWS, file);
+    }
+}
+
+/**
+ * Writes the record of a parking lot followed by its name, its columns and
+ * the stays of the vehicles parked in it.
+ * @param file the snapshot file
+ * @param parking_lot the parking lot
+ */
+static void write_park(FILE *file, ParkingLot *parking_lot) {
+    SnapshotPark record = {parking_lot->capacity,
+    parking_lot->available_spaces, strlen(parking_lot->name),
+    {parking_lot->quarter_hourly_rate,
+    parking_lot->quarter_hourly_rate_after_first_hour,
+    parking_lot->max_daily_cost}, parking_lot->closed.num_rows};
+    fwrite(&record, sizeof(record), 1, file);
+    write_aligned(file, parking_lot->name, record.name_length);
+    for (int i = 0; i < SNAPSHOT_COLUMNS; i++)
+        write_column(file, &parking_lot->closed, column_offsets[i]);
+    Vehicle *stay = parking_lot->parked;
+    for (; stay != NULL; stay = stay->next_in_park) {
+        SnapshotParked parked = {stay->plate, stay->entry};
+        fwrite(&parked, sizeof(parked), 1, file);
+    }
+}
+
+/**
+ * Syncs the directory holding a file, so that a file renamed into it stays
+ * there after a crash.
+ * @param path the file's path
+ * @return 1 if the directory was synced, 0 otherwise
+ */
+static int sync_directory(const char *path) {
+    const char *slash = strrchr(path, '/');
+    char *directory = slash == NULL ? strdup(".") :
+    strndup(path, slash - path + 1);
+    int fd = open(directory, O_RDONLY | O_DIRECTORY);
+    free(directory);
+    int synced = fd != -1 && fsync(fd) == 0;
+    if (fd != -1)
+        close(fd);
+    return synced;
+}
+
+/**
+ * Writes a snapshot of the whole system. It is written and synced to a
+ * temporary file first, which then replaces the snapshot, so an existing
+ * snapshot is never left half written. The directory is synced last, so a
+ * snapshot that was written survives a crash.
+ * @param path the snapshot's path
+ * @param latest the latest date and time registered in the system
+ * @return 1 if the snapshot was written and synced, 0 otherwise
+ */
+int write_snapshot(const char *path, Timestamp latest) {
+    char *temporary = malloc(strlen(path) + sizeof(".tmp"));
+    sprintf(temporary, "%s.tmp", path);
+    FILE *file = fopen(temporary, "wb");
+    if (file == NULL) {
+        free(temporary);
+        return 0;
+    }
+    SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION,
+    SNAPSHOT_BYTE_ORDER, latest, journal.sequence, count_parks()};
+    fwrite(&header, sizeof(header), 1, file);
+    for (int position = 0; position < count_parks(); position++)
+        write_park(file, find_park_by_position(position));
+    int written = !ferror(file) && fflush(file) == 0 &&
+    fsync(fileno(file)) == 0;
+    written = fclose(file) == 0 && written &&
+    rename(temporary, path) == 0 && sync_directory(path);
+    free(temporary);
+    return written;
+}
+
+/**
+ * Takes the next record of a snapshot being read.
+ * @param reader the snapshot reader
+ * @param size the size of the record, which is followed by padding
+ * @return the record or NULL if the snapshot ends before it
+ */
+static const void *take(SnapshotReader *reader, size_t size) {
+    size_t aligned = snapshot_align(size);
+    if (aligned < size || aligned > reader->size - reader->position)
+        return NULL;
+    const void *record = reader->data + reader->position;
+    reader->position += aligned;
+    return record;
+}
+
+/**
+ * Checks whether a stay read from a snapshot could have ended in a parking
+ * lot after the stays already in its columns.
+ * @param parking_lot the parking lot
+ * @param stay the stay
+ * @param latest the latest date and time registered in the snapshot
+ * @return 1 if the stay is valid, 0 otherwise
+ */
+static int is_valid_closed_stay(ParkingLot *parking_lot,
+const ClosedStay *stay, Timestamp latest) {
+    int num_rows = parking_lot->closed.num_rows;
+    Timestamp previous_exit = 0;
+    if (num_rows > 0) {
+        ClosedStay previous;
+        get_closed_stay(&parking_lot->closed, num_rows - 1, &previous);
+        previous_exit = previous.exit;
+    }
+    return is_valid_plate_key(stay->plate) && stay->entry >= 0 &&
+    stay->exit >= stay->entry && stay->exit >= previous_exit &&
+    stay->exit <= latest && stay->parking_fee ==
+    calculate_parking_fee(parking_lot, stay->entry, stay->exit);
+}
+
+/**
+ * Reads the columns of a parking lot and restores its stays that ended.
+ * @param reader the snapshot reader
+ * @param parking_lot the parking lot
+ * @param num_closed the number of rows of the columns
+ * @param latest the latest date and time registered in the snapshot
+ * @return 1 if the columns are valid, 0 otherwise
+ */
+static int read_closed_stays(SnapshotReader *reader, ParkingLot *parking_lot,
+int64_t num_closed, Timestamp latest) {
+    const int64_t *columns[SNAPSHOT_COLUMNS];
+    for (int i = 0; i < SNAPSHOT_COLUMNS; i++)
+        if ((columns[i] = take(reader, num_closed * sizeof(int64_t))) == NULL)
+            return 0;
+    for (int64_t row = 0; row < num_closed; row++) {
+        ClosedStay stay = {(PlateKey)columns[0][row], columns[1][row],
+        columns[2][row], columns[3][row]};
+        if (!is_valid_closed_stay(parking_lot, &stay, latest))
+            return 0;
+        restore_closed_stay(parking_lot, &stay);
+    }
+    return 1;
+}
+
+/**
+ * Reads the stays of the vehicles parked in a parking lot and restores them.
+ * @param reader the snapshot reader
+ * @param parking_lot the parking lot
+ * @param latest the latest date and time registered in the snapshot
+ * @return 1 if the stays are valid, 0 otherwise
+ */
+static int read_parked(SnapshotReader *reader, ParkingLot *parking_lot,
+Timestamp latest) {
+    int num_parked = parking_lot->capacity - parking_lot->available_spaces;
+    const SnapshotParked *parked = take(reader,
+    num_parked * sizeof(SnapshotParked));
+    for (int i = 0; parked != NULL && i < num_parked; i++) {
+        if (!is_valid_plate_key(parked[i].plate) ||
+        is_vehicle_parked(parked[i].plate) ||
+        parked[i].entry < 0 || parked[i].entry > latest)
+            return 0;
+        add_entry_to_hash_table(parked[i].plate, parking_lot,
+        parked[i].entry);
+    }
+    return parked != NULL;
+}
+
+/**
+ * Reads the record of a parking lot, creates it and restores its stays.
+ * @param reader the snapshot reader
+ * @param latest the latest date and time registered in the snapshot
+ * @return 1 if the record and the stays are valid, 0 otherwise
+ */
+static int read_park(SnapshotReader *reader, Timestamp latest) {
+    const SnapshotPark *record = take(reader, sizeof(SnapshotPark));
+    if (record == NULL || record->capacity <= 0 ||
+    record->available_spaces < 0 ||
+    record->available_spaces > record->capacity || record->name_length <= 0 ||
+    record->rates[0] <= 0 || record->rates[1] <= record->rates[0] ||
+    record->rates[2] <= record->rates[1] ||
+    record->rates[2] > (Cents)INT_MAX * CENTS_PER_EURO ||
+    record->num_closed < 0 || record->num_closed > INT_MAX)
+        return 0;
+    const char *name = take(reader, record->name_length);
+    if (name == NULL || memchr(name, '\0', record->name_length) != NULL)
+        return 0;
+    char *copy = strndup(name, record->name_length);
+    Cents rates[3] = {record->rates[0], record->rates[1], record->rates[2]};
+    ParkingLot *parking_lot = find_park_id(copy) == -1 ?
+    add_parking_lot(copy, record->capacity, rates) : NULL;
+    free(copy);
+    if (parking_lot == NULL)
+        return 0;
+    parking_lot->available_spaces = record->available_spaces;
+    if (!read_closed_stays(reader, parking_lot, record->num_closed, latest) ||
+    !read_parked(reader, parking_lot, latest))
+        return 0;
+    // The stays were logged park by park rather than in order of time
+    sort_occupancy_log(&parking_lot->occupancy);
+    return 1;
+}
+
+/**
+ * Reads a whole snapshot, restoring the state it holds.
+ * @param reader the snapshot reader
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if the snapshot is valid, 0 otherwise
+ */
+static int read_snapshot(SnapshotReader *reader, Timestamp *latest) {
+    const SnapshotHeader *header = take(reader, sizeof(SnapshotHeader));
+    if (header == NULL || memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0 ||
+    header->version != SNAPSHOT_VERSION ||
+    header->byte_order != SNAPSHOT_BYTE_ORDER || header->latest < 0 ||
+    header->latest >=
+    make_timestamp(date_to_day(31, 12, SNAPSHOT_MAX_YEAR) + 1, 0, 0) ||
+    header->sequence < 0 ||
+    header->num_parks < 0 || header->num_parks > MAX_PARKS)
+        return 0;
+    for (int64_t i = 0; i < header->num_parks; i++)
+        if (!read_park(reader, header->latest))
+            return 0;
+    *latest = header->latest;
+    journal.sequence = header->sequence;
+    return 1;
+}
+
+/**
+ * Loads a snapshot into the system, which must be empty.
+ * @param path the snapshot's path
+ * @param latest where the latest date and time registered is stored
+ * @return 1 if the snapshot was loaded, 0 if it couldn't be read or is
+ * invalid
+ */
+int load_snapshot(const char *path, Timestamp *latest) {
+    struct stat file_stat;
+    int fd = open(path, O_RDONLY);
+    if (fd == -1 || fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        if (fd != -1)
+            close(fd);
+        return 0;
+    }
+    void *data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return 0;
+    SnapshotReader reader = {data, file_stat.st_size, 0};
+    int loaded = read_snapshot(&reader, latest);
+    munmap(data, file_stat.st_size);
+    return loaded;
+}
@@ -0,0 +1,74 @@
+/**
+ * Header file for snapshot.c
+ * @file snapshot.h
+ * @author @inesiscosta
+*/
+
+#ifndef SNAPSHOT
+#define SNAPSHOT
+
+/*Includes*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "parking_lot.h"
+#include "vehicle.h"
+
+/*Constants*/
+#define SNAPSHOT_MAGIC "PARKSNAP"
+#define SNAPSHOT_VERSION 3
+// Written as a number, reads differently on a machine of another endianness
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+#define SNAPSHOT_ALIGNMENT 8
+#define SNAPSHOT_COLUMNS 4
+// Last year a date may have, times past its end are invalid
+#define SNAPSHOT_MAX_YEAR 99999
+
+/*Snapshot file layout, every record is a multiple of 8 bytes:
+header and then, for each park, its record, its name, the columns of the
+stays that ended in it (plates, entries, exits and fees, each an array of
+num_closed numbers) and the stays of the vehicles parked in it.
+The histories of the vehicles are rebuilt from the stays of every park.*/
+
+/*Snapshot Header Structure*/
+typedef struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    int64_t latest;
+    int64_t sequence; // events applied to the state, see journal.h
+    int64_t num_parks;
+} SnapshotHeader;
+
+/*Snapshot Park Structure*/
+typedef struct SnapshotPark {
+    int32_t capacity;
+    int32_t available_spaces; // capacity minus the number of parked vehicles
+    int64_t name_length; // the name follows, padded to 8 bytes
+    int64_t rates[3];
+    int64_t num_closed; // rows of the park's columns
+} SnapshotPark;
+
+/*Snapshot Parked Structure, the stay of a vehicle that is still parked*/
+typedef struct SnapshotParked {
+    PlateKey plate;
+    int64_t entry;
+} SnapshotParked;
+
+/*Snapshot Reader Structure*/
+typedef struct SnapshotReader {
+    const char *data;
+    size_t size;
+    size_t position;
+} SnapshotReader;
+
+/*Function Prototypes*/
+int write_snapshot(const char *path, Timestamp latest);
+int load_snapshot(const char *path, Timestamp *latest);
+#endif
@@ -0,0 +1,86 @@
+/**
+ * File containing the instrumentation of the park management system.
+ * When built with -DSTATS every command is counted and timed, along with
+ * some internal counters, and everything is dumped to stderr when the
+ * program ends. Otherwise the instrumentation macros compile to nothing.
+ * @file stats.c
+ * @author @inesiscosta
+ */
+
+#include "stats.h"
+#include "parking_lot.h"
+
+Statistics statistics;
+
+/**
+ * Reads a monotonic clock.
+ * @return the current time in nanoseconds
+ */
+static long long current_nanoseconds() {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+/**
+ * Marks the start of a command.
+ * @param type the command's letter
+ */
+void stats_start_command(char type) {
+    statistics.current_command = (unsigned char)type;
+    statistics.command_start = current_nanoseconds();
+}
+
+/**
+ * Marks the end of the current command, counting it and adding its latency
+ * to the histogram of its type.
+ */
+void stats_end_command() {
+    unsigned long long elapsed =
+    current_nanoseconds() - statistics.command_start;
+    CommandStatistics *command =
+    &statistics.commands[statistics.current_command];
+    int bucket = 0;
+    while (elapsed > 1) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    command->count++;
+    command->latency[bucket]++;
+}
+
+/**
+ * Prints the counters and the latency histogram of a type of command.
+ * @param stream where the statistics are printed
+ * @param type the command's letter
+ */
+static void dump_command(FILE *stream, int type) {
+    CommandStatistics *command = &statistics.commands[type];
+    fprintf(stream, "command %c: %llu run, %llu errors\n", type,
+    command->count, command->errors);
+    for (int bucket = 0; bucket < STATS_LATENCY_BUCKETS; bucket++)
+        if (command->latency[bucket] > 0)
+            fprintf(stream, "  < %llu ns: %llu\n", 2ULL << bucket,
+            command->latency[bucket]);
+}
+
+/**
+ * Prints every statistic collected so far.
+ * @param stream where the statistics are printed
+ */
+void stats_dump(FILE *stream) {
+    size_t bytes_used, bytes_reserved;
+    for (int type = 0; type < STATS_COMMAND_TYPES; type++)
+        if (statistics.commands[type].count > 0)
+            dump_command(stream, type);
+    fprintf(stream, "hash lookups: %llu, %llu probe steps\n",
+    statistics.hash_lookups, statistics.hash_probe_steps);
+    fprintf(stream, "park directory lookups: %llu, %llu probe steps\n",
+    statistics.directory_lookups, statistics.directory_probe_steps);
+    fprintf(stream, "billing queries: %llu, %llu records scanned\n",
+    statistics.billing_queries, statistics.billing_records_scanned);
+    fprintf(stream, "allocations: %llu\n", statistics.allocations);
+    stays_memory_usage(&bytes_used, &bytes_reserved);
+    fprintf(stream, "stays: %zu bytes used, %zu bytes reserved\n",
+    bytes_used, bytes_reserved);
+}
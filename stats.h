@@ -0,0 +1,63 @@
+/**
+ * Header file for stats.c
+ * @file stats.h
+ * @author @inesiscosta
+*/
+
+#ifndef STATS_HEADER
+#define STATS_HEADER
+
+/*Includes*/
+#include <stdio.h>
+#include <time.h>
+
+/*Constants*/
+#define STATS_COMMAND_TYPES 256
+// Latencies are grouped by powers of two of nanoseconds
+#define STATS_LATENCY_BUCKETS 64
+
+/*Statistics of one type of command*/
+typedef struct CommandStatistics {
+    unsigned long long count;
+    unsigned long long errors;
+    unsigned long long latency[STATS_LATENCY_BUCKETS];
+} CommandStatistics;
+
+/*Statistics Structure*/
+typedef struct Statistics {
+    CommandStatistics commands[STATS_COMMAND_TYPES];
+    unsigned char current_command;
+    long long command_start; // nanoseconds
+    unsigned long long hash_lookups;
+    unsigned long long hash_probe_steps;
+    unsigned long long directory_lookups;
+    unsigned long long directory_probe_steps;
+    unsigned long long billing_queries;
+    unsigned long long billing_records_scanned;
+    unsigned long long allocations;
+} Statistics;
+
+extern Statistics statistics;
+
+/*Instrumentation, only compiled in when building with -DSTATS*/
+#ifdef STATS
+#define STATS_COUNT(counter) (statistics.counter++)
+#define STATS_ADD(counter, amount) (statistics.counter += (amount))
+#define STATS_START_COMMAND(type) stats_start_command(type)
+#define STATS_END_COMMAND() stats_end_command()
+#define STATS_ERROR() (statistics.commands[statistics.current_command].errors++)
+#define STATS_DUMP() stats_dump(stderr)
+#else
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_ADD(counter, amount) ((void)0)
+#define STATS_START_COMMAND(type) ((void)0)
+#define STATS_END_COMMAND() ((void)0)
+#define STATS_ERROR() ((void)0)
+#define STATS_DUMP() ((void)0)
+#endif
+
+/*Function Prototypes*/
+void stats_start_command(char type);
+void stats_end_command();
+void stats_dump(FILE *stream);
+#endif
@@ -0,0 +1,102 @@
+/**
+ * File containing the columns that hold the stays which ended in a park.
+ * A stay that ended never changes again, so it is appended as a row to
+ * blocks holding each of its fields in a column of its own. The rows of a
+ * park are in order of exit, so the stays that ended on a day, or in a range
+ * of days, are consecutive rows that can be scanned without following any
+ * pointer.
+ * @file stay_columns.c
+ * @author @inesiscosta
+ */
+
+#include "stay_columns.h"
+
+/**
+ * Initializes empty columns.
+ * @param columns the columns to be initialized
+ */
+void stay_columns_init(StayColumns *columns) {
+    columns->blocks = NULL;
+    columns->num_blocks = 0;
+    columns->blocks_capacity = 0;
+    columns->num_rows = 0;
+}
+
+/**
+ * Frees every block of the columns.
+ * @param columns the columns
+ */
+void stay_columns_free(StayColumns *columns) {
+    for (int i = 0; i < columns->num_blocks; i++)
+        free(columns->blocks[i]);
+    free(columns->blocks);
+    stay_columns_init(columns);
+}
+
+/**
+ * Appends a stay that ended to the columns, adding a block if the last one
+ * is full.
+ * @param columns the columns
+ * @param stay the stay
+ * @return the row of the stay
+ */
+int append_closed_stay(StayColumns *columns, const ClosedStay *stay) {
+    int row = columns->num_rows;
+    if (row == columns->num_blocks * STAY_BLOCK_ROWS) {
+        if (columns->num_blocks == columns->blocks_capacity) {
+            columns->blocks_capacity = columns->blocks_capacity == 0 ?
+            INITIAL_STAY_BLOCKS : columns->blocks_capacity * 2;
+            STATS_COUNT(allocations);
+            columns->blocks = (StayBlock **)realloc(columns->blocks,
+            columns->blocks_capacity * sizeof(StayBlock *));
+        }
+        STATS_COUNT(allocations);
+        columns->blocks[columns->num_blocks++] =
+        (StayBlock *)malloc(sizeof(StayBlock));
+    }
+    int index;
+    StayBlock *block = stay_block(columns, row, &index);
+    block->plates[index] = stay->plate;
+    block->entries[index] = stay->entry;
+    block->exits[index] = stay->exit;
+    block->fees[index] = stay->parking_fee;
+    columns->num_rows++;
+    return row;
+}
+
+/**
+ * Gets the block holding a row.
+ * @param columns the columns
+ * @param row the row
+ * @param index where the position of the row in the block is stored
+ * @return the block
+ */
+StayBlock *stay_block(const StayColumns *columns, int row, int *index) {
+    *index = row & (STAY_BLOCK_ROWS - 1);
+    return columns->blocks[row >> STAY_BLOCK_SHIFT];
+}
+
+/**
+ * Reads a row of the columns.
+ * @param columns the columns
+ * @param row the row
+ * @param stay where the stay is stored
+ */
+void get_closed_stay(const StayColumns *columns, int row, ClosedStay *stay) {
+    int index;
+    StayBlock *block = stay_block(columns, row, &index);
+    stay->plate = block->plates[index];
+    stay->entry = block->entries[index];
+    stay->exit = block->exits[index];
+    stay->parking_fee = block->fees[index];
+}
+
+/**
+ * Gets the memory taken by the columns.
+ * @param columns the columns
+ * @return the number of bytes reserved for the columns
+ */
+size_t stay_columns_bytes(const StayColumns *columns) {
+    return columns->num_blocks * sizeof(StayBlock) +
+    columns->blocks_capacity * sizeof(StayBlock *);
+}
@@ -0,0 +1,56 @@
+/**
+ * Header file for stay_columns.c
+ * @file stay_columns.h
+ * @author @inesiscosta
+*/
+
+#ifndef STAY_COLUMNS
+#define STAY_COLUMNS
+
+/*Includes*/
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "datetime.h"
+#include "money.h"
+#include "stats.h"
+#include "plate.h"
+
+/*Constants*/
+// Rows in each block of the columns, a power of 2
+#define STAY_BLOCK_ROWS 1024
+#define STAY_BLOCK_SHIFT 10
+#define INITIAL_STAY_BLOCKS 4
+
+/*Stay Block Structure, a fixed number of rows of every column*/
+typedef struct StayBlock {
+    PlateKey plates[STAY_BLOCK_ROWS];
+    Timestamp entries[STAY_BLOCK_ROWS];
+    Timestamp exits[STAY_BLOCK_ROWS];
+    Cents fees[STAY_BLOCK_ROWS];
+} StayBlock;
+
+/*Stay Columns Structure, the stays that ended in a park in order of exit*/
+typedef struct StayColumns {
+    StayBlock **blocks;
+    int num_blocks;
+    int blocks_capacity;
+    int num_rows;
+} StayColumns;
+
+/*Closed Stay Structure, one row of the columns*/
+typedef struct ClosedStay {
+    PlateKey plate;
+    Timestamp entry;
+    Timestamp exit;
+    Cents parking_fee;
+} ClosedStay;
+
+/*Function Prototypes*/
+void stay_columns_init(StayColumns *columns);
+void stay_columns_free(StayColumns *columns);
+int append_closed_stay(StayColumns *columns, const ClosedStay *stay);
+void get_closed_stay(const StayColumns *columns, int row, ClosedStay *stay);
+StayBlock *stay_block(const StayColumns *columns, int row, int *index);
+size_t stay_columns_bytes(const StayColumns *columns);
+#endif
@@ -0,0 +1,148 @@
+/**
+ * File containing the rankings of a park, of the stays that ended in it,
+ * such as the longest stays, or of the totals its vehicles paid there.
+ * Each ranking keeps only its TOP_RANKED best entries in a min-heap, so a
+ * stay that just ended is compared with the worst of them and, if better,
+ * takes its place in O(log TOP_RANKED). As totals only grow, a vehicle
+ * whose total isn't kept never ranks above the worst of them, which keeps
+ * the ranking of totals exact. Entries with the same value rank in order of
+ * exit.
+ * @file top_stays.c
+ * @author @inesiscosta
+ */
+
+#include "top_stays.h"
+
+/**
+ * Initializes an empty ranking.
+ * @param top the ranking to be initialized
+ */
+void top_stays_init(TopStays *top) {
+    top->size = 0;
+}
+
+/**
+ * Checks whether a stay ranks below another one.
+ * @param stay1 the first stay
+ * @param stay2 the second stay
+ * @return 1 if the first stay has a lower value or the same value and a
+ * later exit, 0 otherwise
+ */
+static int ranks_below(const RankedStay *stay1, const RankedStay *stay2) {
+    return stay1->value < stay2->value ||
+    (stay1->value == stay2->value && stay1->row > stay2->row);
+}
+
+/**
+ * Moves a stay of the heap up until its parent ranks below it.
+ * @param top the ranking
+ * @param position the position of the stay in the heap
+ */
+static void sift_up(TopStays *top, int position) {
+    RankedStay stay = top->heap[position];
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (!ranks_below(&stay, &top->heap[parent]))
+            break;
+        top->heap[position] = top->heap[parent];
+        position = parent;
+    }
+    top->heap[position] = stay;
+}
+
+/**
+ * Moves a stay of the heap down until its children rank above it.
+ * @param top the ranking
+ * @param position the position of the stay in the heap
+ */
+static void sift_down(TopStays *top, int position) {
+    RankedStay stay = top->heap[position];
+    // Never more than TOP_RANKED, bounded so the compiler can tell as well
+    int size = top->size < TOP_RANKED ? top->size : TOP_RANKED, child;
+    while ((child = 2 * position + 1) < size) {
+        if (child + 1 < size &&
+        ranks_below(&top->heap[child + 1], &top->heap[child]))
+            child++;
+        if (!ranks_below(&top->heap[child], &stay))
+            break;
+        top->heap[position] = top->heap[child];
+        position = child;
+    }
+    top->heap[position] = stay;
+}
+
+/**
+ * Adds an entry to a ranking if it is among the best ones, dropping the
+ * worst entry if the ranking is full.
+ * @param top the ranking
+ * @param stay the entry, which isn't in the ranking
+ */
+static void offer_ranked_entry(TopStays *top, const RankedStay *stay) {
+    if (top->size < TOP_RANKED) {
+        top->heap[top->size] = *stay;
+        sift_up(top, top->size++);
+    } else if (ranks_below(&top->heap[0], stay)) {
+        top->heap[0] = *stay;
+        sift_down(top, 0);
+    }
+}
+
+/**
+ * Adds a stay that just ended to a ranking if it is among the best ones,
+ * dropping the worst stay if the ranking is full.
+ * @param top the ranking
+ * @param value the value the stay is ranked by
+ * @param row the row of the stay, after the rows of every stay offered
+ */
+void offer_ranked_stay(TopStays *top, long long value, int row) {
+    RankedStay stay = {value, row, NO_PLATE};
+    offer_ranked_entry(top, &stay);
+}
+
+/**
+ * Updates the ranking of totals after a vehicle's total grew. A total that
+ * is kept moves down the heap to its new place, any other one is offered
+ * as a new entry.
+ * @param top the ranking
+ * @param total the vehicle's new total, not below its previous one
+ * @param row the row of the stay that raised the total, after the rows of
+ * every total offered
+ * @param plate the vehicle's packed plate
+ */
+void raise_ranked_total(TopStays *top, long long total, int row,
+PlateKey plate) {
+    RankedStay stay = {total, row, plate};
+    for (int position = 0; position < top->size; position++)
+        if (top->heap[position].plate == plate) {
+            // A total that didn't grow keeps the exit it was reached at
+            if (total > top->heap[position].value) {
+                top->heap[position] = stay;
+                sift_down(top, position);
+            }
+            return;
+        }
+    offer_ranked_entry(top, &stay);
+}
+
+/**
+ * Compares two ranked stays, to be used with qsort.
+ * @param stay1 pointer to the first stay
+ * @param stay2 pointer to the second stay
+ * @return a negative integer, 0 or a positive integer if the first stay
+ * respectively ranks above, is the same as or ranks below the second one
+ */
+static int compare_ranked_stays(const void *stay1, const void *stay2) {
+    return ranks_below(stay1, stay2) - ranks_below(stay2, stay1);
+}
+
+/**
+ * Gets the entries of a ranking from best to worst.
+ * @param top the ranking
+ * @param stays where the entries are stored
+ * @return the number of entries
+ */
+int sorted_top_stays(const TopStays *top, RankedStay stays[TOP_RANKED]) {
+    memcpy(stays, top->heap, top->size * sizeof(RankedStay));
+    qsort(stays, top->size, sizeof(RankedStay), compare_ranked_stays);
+    return top->size;
+}
@@ -0,0 +1,41 @@
+/**
+ * Header file for top_stays.c
+ * @file top_stays.h
+ * @author @inesiscosta
+*/
+
+#ifndef TOP_STAYS
+#define TOP_STAYS
+
+/*Includes*/
+#include <stdlib.h>
+#include <string.h>
+#include "plate.h"
+
+/*Constants*/
+// Entries kept in each ranking of a park, can be raised with -DTOP_RANKED=<n>
+#ifndef TOP_RANKED
+#define TOP_RANKED 10
+#endif
+
+/*Ranked Stay Structure, a stay that ended or a vehicle's total and the
+value it is ranked by*/
+typedef struct RankedStay {
+    long long value; // a duration in minutes or a total paid in cents
+    int row; // row of the stay, or of the stay that raised the total last
+    PlateKey plate; // vehicle whose total it is, NO_PLATE for a stay
+} RankedStay;
+
+/*Top Stays Structure, a min-heap of the entries with the highest values*/
+typedef struct TopStays {
+    RankedStay heap[TOP_RANKED]; // the lowest ranked stay is at the root
+    int size;
+} TopStays;
+
+/*Function Prototypes*/
+void top_stays_init(TopStays *top);
+void offer_ranked_stay(TopStays *top, long long value, int row);
+void raise_ranked_total(TopStays *top, long long total, int row,
+PlateKey plate);
+int sorted_top_stays(const TopStays *top, RankedStay stays[TOP_RANKED]);
+#endif
@@ -14,28 +14,23 @@
 #include <string.h>
 #include "vehicle.h"
 #include "parking_lot.h"
+#include "datetime.h"
+#include "command.h"
+#include "output.h"
+#include "journal.h"
+#include "plate.h"
+
+/*Forward Declarations*/
+struct ParkingLot;
 
 /*Function Prototypes*/
-void breakdown_datetime(char *date, char *time, int *day, int *month, 
-int *year, int *hours, int *minutes);
-int compare_datetime(char *date1, char *time1, char *date2, char *time2);
-void update_first_date(char *entry_date, char *first_date, 
-char *first_date_set);
-int park_exists(char *name);
-int is_valid_license_plate(char *plate);
-int is_valid_datetime(char *date, char *time, char *latest_date, 
-char *latest_time);
-int is_valid_entry(char *name, char *plate, char *entry_date, 
-char *entry_time, char *latest_date, char *latest_time);
-int is_valid_exit(char *name, char *plate, char *exit_date, char *exit_time, 
-char *latest_date, char *latest_time);
-void format_time(char *time);
+int is_valid_datetime(Timestamp timestamp, Timestamp latest);
+int is_valid_entry(struct ParkingLot *parking_lot, char *name, char *plate,
+PlateKey *key, Timestamp entry, Timestamp latest);
+int is_valid_exit(struct ParkingLot *parking_lot, char *name, char *plate,
+PlateKey *key, Timestamp exit, Timestamp latest);
 void validate_and_call_show_park_billings(char *name, char *date, 
-char *latest_date, char *latest_time);
-void validate_and_call_show_daily_revenue_summary(char *name,
-char *latest_date, char *latest_time, char *first_date);
-int month_days_before(int month);
-int calculate_total_minutes(char *date, char *time);
-void increment_date(char *date);
-void remove_parking_lot(char *command);
+Timestamp latest);
+void validate_and_call_show_daily_revenue_summary(char *name);
+void remove_parking_lot(Command *command);
 #endif
\ No newline at end of file
@@ -13,292 +13,341 @@ HashTable vehicle_hash_table;
  * Initializes the hash table.
  */
 void initialize_hash_table() {
-    vehicle_hash_table.table = (Vehicle **)
-    malloc(INITIAL_HASH_TABLE_SIZE * sizeof(Vehicle *));
-    vehicle_hash_table.head = (Vehicle **)
-    malloc(INITIAL_HASH_TABLE_SIZE * sizeof(Vehicle *));
-    vehicle_hash_table.tail = (Vehicle **)
-    malloc(INITIAL_HASH_TABLE_SIZE * sizeof(Vehicle *));
-    for (int i = 0; i < INITIAL_HASH_TABLE_SIZE; i++) {
-        vehicle_hash_table.table[i] = NULL;
-        vehicle_hash_table.head[i] = NULL;
-        vehicle_hash_table.tail[i] = NULL;
-    }
+    hash_table_init(&vehicle_hash_table);
 }
 
 /**
- * Frees the hash table.
+ * Frees the hash table along with every vehicle history stored in it. The
+ * stays themselves belong to their park.
  */
 void free_hash_table() {
-    for (int i = 0; i < INITIAL_HASH_TABLE_SIZE; i++) {
-        Vehicle *current = vehicle_hash_table.table[i];
-        while (current != NULL) {
-            Vehicle *temp = current;
-            current = current->next;
-            free(temp->name);
-            free(temp);
-        }
+    size_t cursor = 0;
+    VehicleHistory *history;
+    while ((history = hash_table_next(&vehicle_hash_table, &cursor, NULL))
+    != NULL) {
+        free(history->groups);
+        free(history);
     }
-    free(vehicle_hash_table.table);
-    free(vehicle_hash_table.tail);
-    free(vehicle_hash_table.head);
+    hash_table_free(&vehicle_hash_table);
+}
+
+/**
+ * Finds the history of stays of a vehicle.
+ * @param plate the vehicle's packed license plate
+ * @return the vehicle's history or NULL if it never entered a parking lot
+ */
+VehicleHistory *find_vehicle_history(PlateKey plate) {
+    return hash_table_get(&vehicle_hash_table, plate);
 }
 
-/** 
- * A function which given a vehicle's license plate determines where the 
- * vehicle will be/is stored in the hash table.
- * @param license_plate the vehicle license plate
- * @return hash_index the hash table index to which the vehicle with the given
- * license plate will be / is stored
+/**
+ * Finds the stay of a vehicle that hasn't exited its parking lot yet.
+ * @param plate the vehicle's packed license plate
+ * @return the vehicle's current stay or NULL if it isn't parked
  */
-int hash_function(char *license_plate) {
-    int hash_index, a = 31415, b = 27183;
-    for (hash_index = 0; *license_plate != '\0'; license_plate++, a = a * b % 
-    (INITIAL_HASH_TABLE_SIZE - 1))
-        hash_index = (a * hash_index + *license_plate) 
-        % INITIAL_HASH_TABLE_SIZE;
-    return hash_index;
+Vehicle *find_active_stay(PlateKey plate) {
+    VehicleHistory *history = find_vehicle_history(plate);
+    return history != NULL ? history->active : NULL;
 }
 
 /**
  * Checks whether a vehicle is parked in any park.
- * @param license_plate the vehicle's license plate
+ * @param plate the vehicle's packed license plate
  * @return 1 if the vehicles is parked, 0 otherwise 
  */
-int is_vehicle_parked(char *license_plate) {
-    int hash_index = hash_function(license_plate);
-    Vehicle *current = vehicle_hash_table.table[hash_index];
-    while (current != NULL) {
-        if (strcmp(current->license_plate, license_plate) == 0 && 
-        current->exit_date[0] == '\0' && current->exit_time[0] == '\0')
-            return 1;
-        current = current->next;
-    }
-    return 0;
+int is_vehicle_parked(PlateKey plate) {
+    return find_active_stay(plate) != NULL;
 }
 
 /**
  * Checks wether a vehicle is parked in a given park.
- * @param name the parking lot's name
- * @param license_plate the vehicle's license plate
+ * @param parking_lot the parking lot
+ * @param plate the vehicle's packed license plate
  * @return 1 if the vehicle is parked in that parking lot, 0 otherwise 
  */
-int is_vehicle_parked_here(char *name, char *license_plate) {
-    int hash_index = hash_function(license_plate);
-    Vehicle *current = vehicle_hash_table.table[hash_index];
-    while (current != NULL) {
-        if (strcmp(current->license_plate, license_plate) == 0 && 
-        strcmp(current->name, name) == 0 
-        && current->exit_date[0] == '\0' && current->exit_time[0] == '\0')
-            return 1;
-        current = current->next;
+int is_vehicle_parked_here(ParkingLot *parking_lot, PlateKey plate) {
+    Vehicle *stay = find_active_stay(plate);
+    return stay != NULL && stay->park_id == parking_lot->id;
+}
+
+/**
+ * Gets the history of a vehicle, adding an empty one if it has none.
+ * @param plate the vehicle's plate
+ * @return the vehicle's history
+ */
+static VehicleHistory *get_vehicle_history(PlateKey plate) {
+    VehicleHistory *history = find_vehicle_history(plate);
+    if (history == NULL) {
+        STATS_COUNT(allocations);
+        history = (VehicleHistory *)malloc(sizeof(VehicleHistory));
+        *history = (VehicleHistory){NULL, NULL, 0, 0};
+        hash_table_put(&vehicle_hash_table, plate, history);
     }
-    return 0;
+    return history;
+}
+
+/**
+ * Finds the group of a vehicle's stays in a parking lot.
+ * @param history the vehicle's history
+ * @param park_id the id of the parking lot
+ * @return the position of the group's header or -1 if no stay of the
+ * vehicle there ended yet
+ */
+static int find_stay_group(VehicleHistory *history, int park_id) {
+    for (int i = 0; i < history->length;
+    i += GROUP_HEADER_LENGTH + history->groups[i + 1])
+        if (history->groups[i] == park_id)
+            return i;
+    return -1;
+}
+
+/**
+ * Makes room for a vehicle's history to hold more numbers.
+ * @param history the vehicle's history
+ * @param extra the number of numbers about to be added
+ */
+static void reserve_history(VehicleHistory *history, int extra) {
+    if (history->length + extra <= history->capacity)
+        return;
+    history->capacity = history->capacity == 0 ?
+    INITIAL_HISTORY_CAPACITY : history->capacity * 2;
+    STATS_COUNT(allocations);
+    history->groups = (int *)realloc(history->groups,
+    history->capacity * sizeof(int));
+}
+
+/**
+ * Inserts numbers into a vehicle's history, which must have room for them.
+ * @param history the vehicle's history
+ * @param position where the numbers go
+ * @param numbers the numbers
+ * @param count how many numbers there are
+ */
+static void insert_into_history(VehicleHistory *history, int position,
+const int *numbers, int count) {
+    memmove(&history->groups[position + count], &history->groups[position],
+    (history->length - position) * sizeof(int));
+    memcpy(&history->groups[position], numbers, count * sizeof(int));
+    history->length += count;
+}
+
+/**
+ * Adds an empty group of stays in a parking lot to the history of a vehicle,
+ * where the name of the park belongs.
+ * @param history the vehicle's history
+ * @param parking_lot the parking lot
+ * @return the position of the group's header
+ */
+static int add_stay_group(VehicleHistory *history, ParkingLot *parking_lot) {
+    int position = 0, rank = park_name_rank(parking_lot->id);
+    while (position < history->length &&
+    park_name_rank(history->groups[position]) < rank)
+        position += GROUP_HEADER_LENGTH + history->groups[position + 1];
+    int header[GROUP_HEADER_LENGTH] = {parking_lot->id, 0};
+    reserve_history(history, GROUP_HEADER_LENGTH + 1);
+    insert_into_history(history, position, header, GROUP_HEADER_LENGTH);
+    return position;
+}
+
+/**
+ * Adds a parking fee to the total a vehicle paid in a parking lot.
+ * @param group the header of the vehicle's group of stays in the park
+ * @param parking_fee the parking fee
+ * @return the new total
+ */
+static Cents add_to_group_total(int *group, Cents parking_fee) {
+    Cents total;
+    memcpy(&total, group + GROUP_TOTAL, sizeof(Cents));
+    total += parking_fee;
+    memcpy(group + GROUP_TOTAL, &total, sizeof(Cents));
+    return total;
+}
+
+/**
+ * Adds a stay that ended to the history of its vehicle, as the latest of
+ * the vehicle's stays in the same parking lot, and ranks the vehicle's new
+ * total in the park.
+ * @param history the vehicle's history
+ * @param parking_lot the parking lot the stay was in
+ * @param row the row of the stay in the parking lot's columns
+ */
+static void add_closed_stay(VehicleHistory *history, ParkingLot *parking_lot,
+int row) {
+    int position = find_stay_group(history, parking_lot->id);
+    if (position == -1)
+        position = add_stay_group(history, parking_lot);
+    reserve_history(history, 1);
+    insert_into_history(history, position + GROUP_HEADER_LENGTH +
+    history->groups[position + 1]++, &row, 1);
+    ClosedStay stay;
+    get_closed_stay(&parking_lot->closed, row, &stay);
+    raise_ranked_total(&parking_lot->highest_totals,
+    add_to_group_total(&history->groups[position], stay.parking_fee), row,
+    stay.plate);
 }
 
 /**
  * Adds a vehicle's entry parameters to the hash_table
  * @param plate the vehicle's plate
- * @param name the parking lot's name
- * @param entry_date the vehicle's entry date into said parking lot
- * @param entry_time the vehicle's time of entry into said parking lot
- * @param latest_date the latest date entered into the system 
- * @param latest_time the latest time entered into the system
+ * @param parking_lot the parking lot, which holds the new stay
+ * @param entry the vehicle's entry date and time into said parking lot
+ * @return the new stay
  */
-void add_entry_to_hash_table(char *plate, char *name, char *entry_date, 
-char *entry_time, char *latest_date, char *latest_time) {
-    int hash_index = hash_function(plate); 
-    Vehicle *new_vehicle = (Vehicle*) malloc(sizeof(Vehicle));
-    strcpy(new_vehicle->license_plate, plate);
-    new_vehicle->name = strdup(name);
-    strcpy(new_vehicle->entry_date, entry_date);
-    format_time(entry_time);
-    strcpy(new_vehicle->entry_time, entry_time);
-    strcpy(latest_date, entry_date);
-    strcpy(latest_time, entry_time);
-    //Empty strings to indicate that the vehicle has not exited the parking lot
-    strcpy(new_vehicle->exit_date, "");
-    strcpy(new_vehicle->exit_time, ""); 
-    new_vehicle->next = NULL;
-    if (vehicle_hash_table.table[hash_index] == NULL) {
-        vehicle_hash_table.table[hash_index] = new_vehicle;
-        vehicle_hash_table.head[hash_index] = new_vehicle;
-        vehicle_hash_table.tail[hash_index] = new_vehicle;
-    } else {
-        vehicle_hash_table.tail[hash_index]->next = new_vehicle;
-        vehicle_hash_table.tail[hash_index] = new_vehicle;
-    }
+Vehicle *add_entry_to_hash_table(PlateKey plate, ParkingLot *parking_lot,
+Timestamp entry) {
+    VehicleHistory *history = get_vehicle_history(plate);
+    Vehicle *new_vehicle = allocate_stay(parking_lot);
+    new_vehicle->plate = plate;
+    new_vehicle->entry = entry;
+    history->active = new_vehicle;
+    log_occupancy_event(&parking_lot->occupancy, entry, 1);
+    return new_vehicle;
+}
+
+/**
+ * Adds a stay that ended, read from a snapshot, to the columns and the
+ * occupancy log of its parking lot and to the history of its vehicle.
+ * @param parking_lot the parking lot
+ * @param stay the stay, which ended after every stay already in the park
+ */
+void restore_closed_stay(ParkingLot *parking_lot, const ClosedStay *stay) {
+    log_occupancy_event(&parking_lot->occupancy, stay->entry, 1);
+    log_occupancy_event(&parking_lot->occupancy, stay->exit, 0);
+    add_closed_stay(get_vehicle_history(stay->plate), parking_lot,
+    record_exit(parking_lot, stay));
 }
 
 /**
  * Registers a vehicle's entry and print's out the parking lot's name and
  * remaning available spaces
  * @param command command in format"e <name> <plate> <entry_date> <entry_time>"
- * @param latest_date the latest date registered in the system
- * @param latest_time the latest time registered in the system
- * @param first_date the earliest date in the system
- * @param first_date_set a flag indicating if the first date has been set
+ * @param latest the latest date and time registered in the system
  */
-void register_vehicle_entry(char *command, char *latest_date, 
-char *latest_time, char *first_date, char *first_date_set) {
-    char *name = (char *)malloc(BUFSIZ * sizeof(char));
-    char plate[LICENSE_PLATE_LENGTH], entry_date[DATE_LENGTH], 
-    entry_time[TIME_LENGTH];
-    if (sscanf(command, "e \"%[^\"]\" %10s %s %s", name, plate, entry_date,
-    entry_time) == 4 || sscanf(command, "e %s %10s %s %s", name, plate, 
-    entry_date, entry_time) == 4) {
-        name = realloc(name, strlen(name) + 1);
-        if (is_valid_entry(name, plate, entry_date, entry_time, latest_date, 
-        latest_time)) {
-            int available_spaces = 0;
-            update_available_spaces_after_entry(name, &available_spaces);
-            add_entry_to_hash_table(plate, name, entry_date, entry_time, 
-            latest_date, latest_time);
-            update_first_date(entry_date, first_date, first_date_set);
-            printf("%s %d\n", name, available_spaces);
-        }
+void register_vehicle_entry(Command *command, Timestamp *latest) {
+    if (command->num_arguments < 4)
+        return;
+    char *name = command->arguments[0], *plate = command->arguments[1];
+    ParkingLot *parking_lot = find_park_by_name(name);
+    Timestamp entry = parse_datetime(command->arguments[2],
+    command->arguments[3]);
+    PlateKey key;
+    if (is_valid_entry(parking_lot, name, plate, &key, entry, *latest)) {
+        int available_spaces = update_available_spaces_after_entry(parking_lot);
+        add_entry_to_hash_table(key, parking_lot, entry);
+        journal_event('e', parking_lot->id, key, entry);
+        *latest = entry;
+        write_string(name);
+        write_char(' ');
+        write_integer(available_spaces);
+        write_char('\n');
     }
-    free(name);
 }
 
 /**
- * Updates the exit date and time in the hash table and calculates and
- * also updates the parking fee.
- * @param name the parking lot's name
- * @param plate the vehicle's plate
- * @param exit_date the vehicle's exit date
- * @param exit_time the vehicle's exit time
- * @param entry_date the vehicle's entry date
- * @param entry_time the vehicle's entry time
- * @param parking_fee the parking fee of the vehicle
+ * Ends the stay of a parked vehicle, moving it to the columns of its parking
+ * lot along with its parking fee.
+ * @param parking_lot the parking lot
+ * @param plate the vehicle's packed plate
+ * @param exit the vehicle's exit date and time
+ * @return the row of the stay that just ended in the park's columns
  */
-void update_exit_params(char *name, char *plate, char *exit_date, 
-char *exit_time, char *entry_date, char *entry_time, float *parking_fee) {
-int hash_index = hash_function(plate);
-    Vehicle *current = vehicle_hash_table.table[hash_index];
-    while (current != NULL) {
-        if (strcmp(current->license_plate, plate) == 0 && 
-            strcmp(current->name, name) == 0 && 
-            current->exit_date[0] == '\0' && 
-            current->exit_time[0] == '\0') {
-            format_time(exit_time); //HH:MM
-            strcpy(current->exit_date, exit_date);
-            strcpy(current->exit_time, exit_time);
-            strcpy(entry_date, current->entry_date);
-            strcpy(entry_time, current->entry_time);
-            //Update available space + calculate parking fee
-            manage_parking_lot_after_exit(name, parking_fee, entry_date,
-                                          entry_time, exit_date, exit_time);
-            current->parking_fee = *parking_fee;
-            break;
-        }
-        current = current->next;
-    }
+int update_exit_params(ParkingLot *parking_lot, PlateKey plate,
+Timestamp exit) {
+    VehicleHistory *history = find_vehicle_history(plate);
+    //Update available space + calculate parking fee
+    int row = manage_parking_lot_after_exit(parking_lot, history->active,
+    exit);
+    history->active = NULL;
+    add_closed_stay(history, parking_lot, row);
+    return row;
 }
 
 /**
  * Registers a vehicle's exit and prints out the vehicle's plate, entry date,
  * entry time, exit date, exit time and parking fee.
  * @param command command in format "s <name> <plate> <exit_date> <exit_time>"
- * @param latest_date the latest date registered in the system
- * @param latest_time the latest time registered in the system
+ * @param latest the latest date and time registered in the system
  */
-void register_vehicle_exit(char *command, char *latest_date, 
-char *latest_time) {
-    char *name = (char *)malloc(BUFSIZ * sizeof(char));
-    char plate[LICENSE_PLATE_LENGTH], exit_date[DATE_LENGTH], 
-    exit_time[TIME_LENGTH];
-    float parking_fee = 0.0;
-    if (sscanf(command, "s \"%[^\"]\" %10s %s %s", name, plate, exit_date, 
-    exit_time) == 4 || sscanf(command, "s %s %10s %s %s", name, plate, 
-    exit_date, exit_time) == 4) {
-        name = realloc(name, strlen(name) + 1);
-        if (is_valid_exit(name, plate, exit_date, exit_time, latest_date, 
-        latest_time)) {
-            char entry_date[DATE_LENGTH], entry_time[TIME_LENGTH];
-            update_exit_params(name, plate, exit_date, exit_time, 
-            entry_date, entry_time, &parking_fee);
-            printf("%s %s %s %s %s %.2f\n", plate, entry_date, 
-                entry_time, exit_date, exit_time, parking_fee);
-            strcpy(latest_date, exit_date);
-            strcpy(latest_time, exit_time); 
-        }
+void register_vehicle_exit(Command *command, Timestamp *latest) {
+    if (command->num_arguments < 4)
+        return;
+    char *name = command->arguments[0], *plate = command->arguments[1];
+    ParkingLot *parking_lot = find_park_by_name(name);
+    Timestamp exit = parse_datetime(command->arguments[2],
+    command->arguments[3]);
+    PlateKey key;
+    if (is_valid_exit(parking_lot, name, plate, &key, exit, *latest)) {
+        ClosedStay stay;
+        get_closed_stay(&parking_lot->closed,
+        update_exit_params(parking_lot, key, exit), &stay);
+        journal_event('s', parking_lot->id, key, exit);
+        write_string(plate);
+        write_char(' ');
+        write_datetime(stay.entry);
+        write_char(' ');
+        write_datetime(stay.exit);
+        write_char(' ');
+        write_money(stay.parking_fee);
+        write_char('\n');
+        *latest = exit;
     }
-    free(name);
 }
 
 /**
- * Compares two vehicle entries by their name, entry date and entry time.
- * @param vehicle_entry1 the first vehicle entry
- * @param vehicle_entry2 the second vehicle entry
- * @return 0 if the entries are equal, 
- * a positive integer if vehicle_entry1 > vehicle_entry2,
- * a negative integer if vehicle_entry1 < vehicle_entry2
+ * Displays a stay of a vehicle that ended in format:
+ * <name> <entry_date> <entry_time> <exit_date> <exit_time>.
+ * @param parking_lot the parking lot
+ * @param row the row of the stay in the parking lot's columns
  */
-int compare_vehicle_entries(const void *vehicle_entry1, 
-const void *vehicle_entry2) {
-    Vehicle *entry1 = *(Vehicle **)vehicle_entry1;
-    Vehicle *entry2 = *(Vehicle **)vehicle_entry2;
-    int comparison_result = strcmp(entry1->name, entry2->name);
-    if (comparison_result != 0)
-        return comparison_result;
-    comparison_result = compare_datetime(entry1->entry_date,
-    entry1->entry_time, entry2->entry_date, entry2->entry_time);
-    return comparison_result;
+static void display_closed_stay(ParkingLot *parking_lot, int row) {
+    int index;
+    StayBlock *block = stay_block(&parking_lot->closed, row, &index);
+    write_string(parking_lot->name);
+    write_char(' ');
+    write_datetime(block->entries[index]);
+    write_char(' ');
+    write_datetime(block->exits[index]);
+    write_char('\n');
 }
 
 /**
- * Sorts the billings array by license plate using Insertion Sort.
- * @param billings the array of billings
- * @param num_billings the number of billings in the array
+ * Displays the stay of a parked vehicle in format:
+ * <name> <entry_date> <entry_time>.
+ * @param stay the stay
  */
-void sort_entries(Vehicle *entries[], int num_entries) {
-    for (int i = 1; i < num_entries; i++) {
-        Vehicle *key = entries[i];
-        int j = i - 1;
-        while (j >= 0 && compare_vehicle_entries(&entries[j], &key) > 0) {
-            entries[j + 1] = entries[j];
-            j = j - 1;
-        }
-        entries[j + 1] = key;
-    }
+static void display_active_stay(Vehicle *stay) {
+    write_string(find_park_by_id(stay->park_id)->name);
+    write_char(' ');
+    write_datetime(stay->entry);
+    write_char('\n');
 }
 
 /**
- * Displays the vehicle entries in format:
- * <name> <entry_date> <entry_time> <exit_date> <exit_time>.
- * @param entries the array of vehicle entries
- * @param num_entries the number of vehicle entries in the array
+ * Displays the stays of a vehicle sorted by the name of their parking lot
+ * and then by their entry, which is the order the history already keeps
+ * them in. The active stay, if any, is the latest of its park.
+ * @param history the vehicle's history
  */
-void display_entries(Vehicle *entries[], int num_entries) {
-    for (int i = 0; i < num_entries; i++) {
-        if (strlen(entries[i]->exit_date) == 0 && 
-        strlen(entries[i]->exit_time) == 0) {
-            printf("%s %s %s\n", entries[i]->name, entries[i]->entry_date, 
-            entries[i]->entry_time);
-        } else {
-            printf("%s %s %.5s %s %.5s\n", entries[i]->name, 
-            entries[i]->entry_date, entries[i]->entry_time, 
-            entries[i]->exit_date, entries[i]->exit_time);
+void display_entries(VehicleHistory *history) {
+    Vehicle *active = history->active;
+    int active_rank = active != NULL ? park_name_rank(active->park_id) : 0;
+    int *group = history->groups, *end = group + history->length;
+    while (group < end) {
+        ParkingLot *parking_lot = find_park_by_id(group[0]);
+        if (active != NULL && active_rank < park_name_rank(group[0])) {
+            display_active_stay(active);
+            active = NULL;
+        }
+        int *rows = group + GROUP_HEADER_LENGTH;
+        for (group = rows + group[1]; rows < group; rows++)
+            display_closed_stay(parking_lot, *rows);
+        if (active != NULL && active->park_id == parking_lot->id) {
+            display_active_stay(active);
+            active = NULL;
         }
     }
-}
-
-/**
- * Counts the number of entries for a given vehicle by their license plate.
- * @param plate the license plate
- * @return the number of entries for the given license plate
- */
-int count_entries_for_plate(char *plate) {
-    int hash_index = hash_function(plate);
-    Vehicle *current = vehicle_hash_table.table[hash_index];
-    int num_entries = 0;
-    while (current != NULL) {
-        if (strcmp(current->license_plate, plate) == 0)
-            num_entries++;
-        current = current->next;
-    }
-    return num_entries;
+    if (active != NULL)
+        display_active_stay(active);
 }
 
 /**
@@ -307,184 +356,150 @@ int count_entries_for_plate(char *plate) {
  * entries are found.
  * @param command command in format "v <plate>"
  */
-void list_vehicle_entries_and_exits(char *command) {
-    char plate[LICENSE_PLATE_LENGTH];
-    sscanf(command, "v %s", plate);
-    if (!is_valid_license_plate(plate)) {
-        printf("%s: invalid licence plate.\n", plate);
+void list_vehicle_entries_and_exits(Command *command) {
+    if (command->num_arguments < 1)
         return;
-    }
-    int num_entries = count_entries_for_plate(plate);
-    if (num_entries == 0) {
-        printf("%s: no entries found in any parking.\n", plate);
+    char *plate = command->arguments[0];
+    PlateKey key;
+    if (!parse_plate(plate, &key)) {
+        write_message(plate, "invalid licence plate.");
         return;
     }
-    Vehicle *entries[num_entries];
-    int hash_index = hash_function(plate);
-    Vehicle *current = vehicle_hash_table.table[hash_index];
-    int index = 0;
-    while (current != NULL) {
-        if (strcmp(current->license_plate, plate) == 0)
-            entries[index++] = current;
-        current = current->next;
+    VehicleHistory *history = find_vehicle_history(key);
+    if (history == NULL) {
+        write_message(plate, "no entries found in any parking.");
+        return;
     }
-    sort_entries(entries, num_entries);
-    display_entries(entries, num_entries);
+    display_entries(history);
 }
 
 /**
- * Finds and stores the billings for a given parking lot's name and date.
- * @param name the parking lot's name
- * @param date the date for which the billings are to be found
- * @param billings array of Vehicles to store the billings
- * @param num_billings number of billing entries found
- * @param parking_lot 
+ * Shows the parking lot a vehicle is currently parked in along with its entry
+ * date and time.
+ * Or prints a descriptive error message if the license plate is invalid or the
+ * vehicle isn't parked.
+ * @param command command in format "w <plate>"
  */
-void find_and_store_billings(char *name, char *date, Vehicle billings[], 
-int *num_billings) {
-    for (int i = 0; i < INITIAL_HASH_TABLE_SIZE; i++) {
-        Vehicle *current = vehicle_hash_table.table[i];
-        while (current != NULL) {
-            if (strcmp(current->name, name) == 0 && 
-            strcmp(current->exit_date, date) == 0) {
-                strcpy(billings[*num_billings].license_plate, 
-                current->license_plate);
-                strcpy(billings[*num_billings].exit_time, current->exit_time);
-                billings[*num_billings].parking_fee = current->parking_fee;
-                (*num_billings)++;
-            }
-            current = current->next;
-        }
+void show_vehicle_location(Command *command) {
+    if (command->num_arguments < 1)
+        return;
+    char *plate = command->arguments[0];
+    PlateKey key;
+    if (!parse_plate(plate, &key)) {
+        write_message(plate, "invalid licence plate.");
+        return;
+    }
+    Vehicle *stay = find_active_stay(key);
+    if (stay == NULL) {
+        write_message(plate, "not in any parking.");
+        return;
     }
+    write_string(find_park_by_id(stay->park_id)->name);
+    write_char(' ');
+    write_datetime(stay->entry);
+    write_char('\n');
 }
 
 /**
  * Extracts arguments from command f and determines which function to call to 
  * validate and list billings depending on the number of arguments extracted.
  * @param command command in format "f <name> <date>" or "f <name>"
- * @param latest_date the latest date registered in the system
- * @param latest_time the latest time registered in the system
- * @param first_date the earliest date registered in the system
+ * @param latest the latest date and time registered in the system
  */
-void list_billings(char *command, char *latest_date, 
-char *latest_time, char *first_date) {
-    char date[DATE_LENGTH];
-    char *name = (char *)malloc(BUFSIZ * sizeof(char));
-    if (sscanf(command, "f \"%[^\"]\" %s", name, date) == 2) {
-        validate_and_call_show_park_billings(name, date, latest_date,
-        latest_time);
-    } else if (sscanf(command, "f \"%[^\"]\"", name) == 1) {
-        validate_and_call_show_daily_revenue_summary(name, latest_date,
-        latest_time, first_date);
-    } else if (sscanf(command, "f %s %s", name, date) == 2) {
-        validate_and_call_show_park_billings(name, date, latest_date,
-        latest_time);
-    } else if (sscanf(command, "f %s", name) == 1) {
-        validate_and_call_show_daily_revenue_summary(name, latest_date,
-        latest_time, first_date);
-    }
+void list_billings(Command *command, Timestamp latest) {
+    if (command->num_arguments >= 2)
+        validate_and_call_show_park_billings(command->arguments[0],
+        command->arguments[1], latest);
+    else if (command->num_arguments == 1)
+        validate_and_call_show_daily_revenue_summary(command->arguments[0]);
 }
 
 /**
- * An insertion sort algorithm to sort the billings array by exit time.
+ * Displays the billings of a day in format:
+ * <plate> <exit_time> <parking_fee>.
+ * The rows are read a block at a time, straight from the plate, exit and
+ * fee columns.
+ * @param columns the columns of the parking lot
+ * @param first_row the row of the first stay that ended that day
+ * @param num_billings the number of stays that ended that day
  */
-void sort_billings(Vehicle billings[], int num_billings) {
-    for (int i = 1; i < num_billings; i++) {
-        Vehicle key = billings[i];
-        int j = i - 1;
-        while (j >= 0 && strcmp(billings[j].exit_time, key.exit_time) > 0) {
-            billings[j + 1] = billings[j];
-            j = j - 1;
+void display_billings(const StayColumns *columns, int first_row,
+int num_billings) {
+    int row = first_row, end = first_row + num_billings, index;
+    while (row < end) {
+        StayBlock *block = stay_block(columns, row, &index);
+        int last = end - row < STAY_BLOCK_ROWS - index ?
+        index + end - row : STAY_BLOCK_ROWS;
+        for (; index < last; index++, row++) {
+            write_bytes((const char *)&block->plates[index], PLATE_CHARACTERS);
+            write_char(' ');
+            write_time(block->exits[index]);
+            write_char(' ');
+            write_money(block->fees[index]);
+            write_char('\n');
         }
-        billings[j + 1] = key;
     }
 }
 
 /**
- * Displays the billings array.
+ * Shows the billings of a parking lot on a given date, which the park's
+ * ledger already keeps sorted by exit time.
+ * @param parking_lot the parking lot
+ * @param day the day for which the billings are to be shown
  */
-void display_billings(Vehicle billings[], int num_billings) {
-    for (int i = 0; i < num_billings; i++) {
-        printf("%s %s %.2f\n", billings[i].license_plate, 
-        billings[i].exit_time, billings[i].parking_fee);
+void show_park_billings(ParkingLot *parking_lot, int day) {
+    DailyRevenue *entry = find_daily_revenue(parking_lot, day);
+    STATS_COUNT(billing_queries);
+    if (entry != NULL) {
+        STATS_ADD(billing_records_scanned, entry->num_exits);
+        display_billings(&parking_lot->closed, entry->first_row,
+        entry->num_exits);
     }
 }
 
 /**
- * Sorts the array billings by license plate.
- * @param billings the array of billings
- * @param num_billings the number of billings in the array
+ * Removes the stays in a parking lot from the history of a vehicle, which is
+ * freed if no stay is left.
+ * @param plate the vehicle's packed plate
+ * @param park_id the parking lot's id
  */
-void show_park_billings(char *name, char *date) {
-    Vehicle billings[INITIAL_HASH_TABLE_SIZE];
-    int num_billings = 0;
-    find_and_store_billings(name, date, billings, &num_billings);
-    sort_billings(billings, num_billings);
-    display_billings(billings, num_billings);
-    free(name);
-}
-
-/**
- * Shows the revenue made by a parking lot day by day.
- * @param name the name of the parking lot
- * @param latest_date the latest date registered in the system
- * @param latest_time the latest time registered in the system
- * @param first_date the string of the first date stored in the system
- */
-void show_daily_revenue_summary(char *name, char *latest_date, 
-char *latest_time, char *first_date) {
-    char date[DATE_LENGTH] = "01-01-0000";
-    strcpy(date, first_date);
-    while (compare_datetime(date, "00:00", latest_date, latest_time) <= 0) {
-        float total_daily_revenue = 0.0;
-        int parking_lot_index = find_parking_lot_index(name);
-        if (parking_lot_index != -1) {
-            for (int i = 0; i < INITIAL_HASH_TABLE_SIZE; i++) {
-                Vehicle *current = vehicle_hash_table.table[i];
-                while (current != NULL) {
-                    if (strcmp(current->name, name) == 0 && 
-                    strcmp(current->exit_date, date) == 0)
-                        total_daily_revenue += current->parking_fee;
-                    current = current->next;
-                }
-            }
-            if (total_daily_revenue != 0) {
-                printf("%s %.2f\n", date, total_daily_revenue);
-            }
-        }
-        increment_date(date);
+void remove_park_from_history(PlateKey plate, int park_id) {
+    VehicleHistory *history = find_vehicle_history(plate);
+    if (history == NULL)
+        return;
+    if (history->active != NULL && history->active->park_id == park_id)
+        history->active = NULL;
+    int position = find_stay_group(history, park_id);
+    if (position != -1) {
+        int removed = GROUP_HEADER_LENGTH + history->groups[position + 1];
+        history->length -= removed;
+        memmove(&history->groups[position],
+        &history->groups[position + removed],
+        (history->length - position) * sizeof(int));
+    }
+    if (history->length == 0 && history->active == NULL) {
+        hash_table_remove(&vehicle_hash_table, plate);
+        free(history->groups);
+        free(history);
     }
-    free(name);
 }
 
 /**
- * Removes all entries for a given parking lot.
- * @param name the parking lot's name
+ * Removes all entries for a given parking lot from the vehicle histories,
+ * following the parking lot's own columns and list of parked vehicles so
+ * that only the vehicles which used it are visited. The stays themselves
+ * are released along with the parking lot.
+ * @param parking_lot the parking lot
  */
-void remove_entries_for_parking_lot(char *name) {
-    for (int i = 0; i < INITIAL_HASH_TABLE_SIZE; i++) {
-        Vehicle *current = vehicle_hash_table.table[i];
-        Vehicle *prev = NULL;
-        while (current != NULL) {
-            if (strcmp(current->name, name) == 0) {
-                if (prev == NULL) {
-                    vehicle_hash_table.table[i] = current->next;
-                    if (current == vehicle_hash_table.tail[i])
-                        vehicle_hash_table.tail[i] = NULL;
-                } else {
-                    prev->next = current->next;
-                    if (current == vehicle_hash_table.tail[i])
-                        vehicle_hash_table.tail[i] = prev;
-                }
-                free(current->name);
-                free(current);
-                current = (prev == NULL) ? vehicle_hash_table.table[i] : prev->next;
-            } else {
-                prev = current;
-                current = current->next;
-            }
-        }
+void remove_entries_for_parking_lot(ParkingLot *parking_lot) {
+    for (int row = 0; row < parking_lot->closed.num_rows; row++) {
+        int index;
+        StayBlock *block = stay_block(&parking_lot->closed, row, &index);
+        remove_park_from_history(block->plates[index], parking_lot->id);
     }
+    Vehicle *stay = parking_lot->parked;
+    for (; stay != NULL; stay = stay->next_in_park)
+        remove_park_from_history(stay->plate, parking_lot->id);
+    parking_lot->parked = NULL;
+    parking_lot->free_stays = NULL;
 }
-
-
@@ -14,60 +14,66 @@
 #include <string.h>
 #include "parking_lot.h"
 #include "utils.h"
+#include "hash_table.h"
+#include "datetime.h"
+#include "money.h"
+#include "command.h"
+#include "output.h"
+#include "journal.h"
+#include "stay_columns.h"
+#include "plate.h"
 
 /*Constants*/
-#define INITIAL_HASH_TABLE_SIZE 128
-#define LICENSE_PLATE_LENGTH 9
-#define DATE_LENGTH 11
-#define TIME_LENGTH 6
+#define INITIAL_HISTORY_CAPACITY 8
+// A group of stays starts with its park's id, its number of rows and the
+// total the vehicle paid in the park, which takes the room of a few ints
+#define GROUP_TOTAL 2
+#define GROUP_HEADER_LENGTH (GROUP_TOTAL + (int)(sizeof(Cents) / sizeof(int)))
 
-/*Vehicle Structure*/
+/*Vehicle Structure, the stay of a vehicle that is still parked*/
 typedef struct Vehicle {
-    char license_plate[LICENSE_PLATE_LENGTH];
-    char *name;
-    char entry_date[DATE_LENGTH];
-    char entry_time[TIME_LENGTH];
-    char exit_date[DATE_LENGTH];
-    char exit_time[TIME_LENGTH];
-    float parking_fee;
-    struct Vehicle *next;
+    PlateKey plate;
+    int park_id; // id of the parking lot, which holds the park's name
+    Timestamp entry;
+    struct Vehicle *next_in_park; // next vehicle parked in the same park
+    struct Vehicle *prev_in_park;
 } Vehicle;
 
-/*Hash Table Structure*/
-typedef struct HashTable {
-    Vehicle **table;
-    Vehicle **head;
-    Vehicle **tail;
-} HashTable;
+/*Vehicle History Structure*/
+typedef struct VehicleHistory {
+    Vehicle *active; // stay of the vehicle while it's parked, NULL otherwise
+    // Groups of the stays that ended in each park, sorted by the park's name:
+    // a header and then the stays' rows in the park's columns, in order
+    int *groups;
+    int length;
+    int capacity;
+} VehicleHistory;
+
+/*Forward Declarations*/
+struct ParkingLot;
 
 /*Function Prototypes*/
 void initialize_hash_table();
 void free_hash_table();
-int hash_function(char *license_plate);
-int is_vehicle_parked(char *license_plate);
-int is_vehicle_parked_here(char *name, char *license_plate);
-void add_entry_to_hash_table(char *plate, char *name, char *entry_date, 
-char *entry_time, char *latest_date, char *latest_time);
-void register_vehicle_entry(char *command, char *latest_date, 
-char *latest_time, char *first_date, char *first_date_set);
-void update_exit_params(char *name, char *plate, char *exit_date, 
-char *exit_time, char *entry_date, char *entry_time, float *parking_fee);
-void register_vehicle_exit(char *command, char *latest_date, 
-char *latest_time);
-int compare_vehicle_entries(const void *vehicle_entry1, 
-const void *vehicle_entry2);
-void sort_entries(Vehicle *entries[], int num_entries);
-void display_entries(Vehicle *entries[], int num_entries);
-int count_entries_for_plate(char *plate);
-void list_vehicle_entries_and_exits(char *command);
-void find_and_store_billings(char *name, char *date, Vehicle billings[], 
-int *num_billings);
-void list_billings(char *command, char *latest_date, 
-char *latest_time, char *first_date);
-void sort_billings(Vehicle billings[], int num_billings);
-void display_billings(Vehicle billings[], int num_billings);
-void show_park_billings(char *name, char *date);
-void show_daily_revenue_summary(char *name, char *latest_date, 
-char *latest_time, char *first_date);
-void remove_entries_for_parking_lot(char *name);
+VehicleHistory *find_vehicle_history(PlateKey plate);
+Vehicle *find_active_stay(PlateKey plate);
+int is_vehicle_parked(PlateKey plate);
+int is_vehicle_parked_here(struct ParkingLot *parking_lot, PlateKey plate);
+Vehicle *add_entry_to_hash_table(PlateKey plate,
+struct ParkingLot *parking_lot, Timestamp entry);
+void restore_closed_stay(struct ParkingLot *parking_lot,
+const ClosedStay *stay);
+void register_vehicle_entry(Command *command, Timestamp *latest);
+int update_exit_params(struct ParkingLot *parking_lot, PlateKey plate,
+Timestamp exit);
+void register_vehicle_exit(Command *command, Timestamp *latest);
+void display_entries(VehicleHistory *history);
+void list_vehicle_entries_and_exits(Command *command);
+void show_vehicle_location(Command *command);
+void list_billings(Command *command, Timestamp latest);
+void display_billings(const StayColumns *columns, int first_row,
+int num_billings);
+void show_park_billings(struct ParkingLot *parking_lot, int day);
+void remove_park_from_history(PlateKey plate, int park_id);
+void remove_entries_for_parking_lot(struct ParkingLot *parking_lot);
 #endif
\ No newline at end of file